@@ -2,6 +2,8 @@
 #include "i18ncpp.h"
 #include <string>
 #include <ctime>
+#include <chrono>
+#include <vector>
 
 static std::string fixturesDir() {
     return FIXTURES_DIR;
@@ -60,6 +62,79 @@ int main() {
         volatile auto r = i18n.formatDate("short_time", &fixed_time);
     }));
 
+    // BM_FormatCompact: follower counts across magnitudes
+    const int64_t counts[] = {987, 12345, 3456789, 7890123456};
+    size_t nextCount = 0;
+    results.push_back(bench::run_benchmark("FormatCompact", ITERATIONS, [&]() {
+        volatile auto r = i18n.formatCompact(counts[nextCount++ & 3]);
+    }));
+
+    // BM_FormatPercent: ratio as a percentage
+    results.push_back(bench::run_benchmark("FormatPercent", ITERATIONS, [&]() {
+        volatile auto r = i18n.formatPercent(0.4567);
+    }));
+
+    // BM_FormatRelative: one activity-feed timestamp
+    results.push_back(bench::run_benchmark("FormatRelative", ITERATIONS, [&]() {
+        volatile auto r = i18n.formatRelative(std::chrono::seconds(-187));
+    }));
+
+    // BM_FormatRelativeBatch: a time-sorted feed of 50 items per call
+    std::vector<std::chrono::seconds> feed;
+    for (int i = 0; i < 50; ++i) {
+        feed.push_back(std::chrono::seconds(-30 - i * i * 40));
+    }
+    i18n::BatchOutput feedOut;
+    results.push_back(bench::run_benchmark("FormatRelativeBatch50", ITERATIONS / 50, [&]() {
+        i18n.formatRelativeBatch(feed, feedOut);
+    }));
+
+    // BM_FormatListInto: four items into a reused buffer
+    const std::string_view listItems[] = {"Alice", "Bob", "Carol", "Dave"};
+    std::string listOut;
+    results.push_back(bench::run_benchmark("FormatListInto", ITERATIONS, [&]() {
+        listOut.clear();
+        i18n.formatListInto(listOut, listItems);
+    }));
+
+    // BM_FormatDurationInto: hours, minutes and seconds into a reused buffer
+    std::string durationOut;
+    results.push_back(bench::run_benchmark("FormatDurationInto", ITERATIONS, [&]() {
+        durationOut.clear();
+        i18n.formatDurationInto(durationOut, std::chrono::seconds(8130));
+    }));
+
+    // BM_FormatOrdinalInto: a rank into a reused buffer
+    std::string ordinalOut;
+    int64_t rank = 0;
+    results.push_back(bench::run_benchmark("FormatOrdinalInto", ITERATIONS, [&]() {
+        ordinalOut.clear();
+        rank = (rank + 1) % 1000;
+        i18n.formatOrdinalInto(ordinalOut, rank);
+    }));
+
+    // BM_FormatPriceCurrencies: a page of prices in several currencies
+    i18n.configure(nlohmann::json::parse(R"({"currencies": {
+        "EUR": {"symbol": "€"}, "GBP": {"symbol": "£"}, "JPY": {"symbol": "¥", "fract_digits": 0}
+    }})"));
+    const char* codes[] = {"EUR", "GBP", "JPY", "USD"};
+    size_t next = 0;
+    results.push_back(bench::run_benchmark("FormatPriceCurrencies", ITERATIONS, [&]() {
+        volatile auto r = i18n.formatPrice(1234.5, codes[next++ & 3]);
+    }));
+
+    // BM_FormatPriceReconfigure: same, switching currencies with configure()
+    const nlohmann::json configs[] = {
+        {{"currency", {{"symbol", "€"}, {"fract_digits", 2}}}},
+        {{"currency", {{"symbol", "£"}, {"fract_digits", 2}}}},
+        {{"currency", {{"symbol", "¥"}, {"fract_digits", 0}}}},
+        {{"currency", {{"symbol", "$"}, {"fract_digits", 2}}}}
+    };
+    results.push_back(bench::run_benchmark("FormatPriceReconfigure", ITERATIONS, [&]() {
+        i18n.configure(configs[next++ & 3]);
+        volatile auto r = i18n.formatPrice(1234.5);
+    }));
+
     std::cout << "\n=== Formatting Benchmarks ===\n\n";
     bench::print_results(results);
 
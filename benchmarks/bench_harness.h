@@ -9,12 +9,169 @@
 #include <algorithm>
 #include <numeric>
 
+#ifdef BENCH_COUNT_ALLOCS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#endif
+
+// Allocation-counting mode (-DI18N_BENCH_COUNT_ALLOCS=ON).
+//
+// Replaces the global operator new/delete for the benchmark executable and
+// reports allocations and bytes per operation next to ns/op. Replacement
+// allocation functions must be defined exactly once per program, so this
+// header may only be included from a single translation unit per benchmark
+// executable (which is how every bench_*.cpp uses it).
+#ifdef BENCH_COUNT_ALLOCS
+
+namespace bench::detail {
+
+inline std::atomic<size_t> alloc_count{0};
+inline std::atomic<size_t> alloc_bytes{0};
+
+inline void* counted_alloc(std::size_t size) {
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+} // namespace bench::detail
+
+void* operator new(std::size_t size) { return bench::detail::counted_alloc(size); }
+void* operator new[](std::size_t size) { return bench::detail::counted_alloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+#endif // BENCH_COUNT_ALLOCS
+
+// Hardware performance counter mode (-DI18N_BENCH_PERF_COUNTERS=ON).
+//
+// On Linux, opens perf_event_open counters for the calling thread and reports
+// per-op cycles, instructions, L1d read misses, LLC misses and branch misses
+// for the timed loop. Each counter is opened independently: counters the PMU
+// or the kernel refuses (perf_event_paranoid, containers, VMs without a
+// virtual PMU) are reported as "n/a" and the benchmark still runs. Other
+// platforms compile the mode out entirely.
+#if defined(BENCH_PERF_COUNTERS) && defined(__linux__)
+#define BENCH_HAS_PERF_COUNTERS 1
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 namespace bench {
 
+#ifdef BENCH_HAS_PERF_COUNTERS
+
+constexpr size_t kPerfCounterCount = 5;
+
+inline constexpr std::array<const char*, kPerfCounterCount> kPerfCounterNames = {
+    "cycles/op", "instr/op", "L1d-miss/op", "LLC-miss/op", "br-miss/op"
+};
+
+class PerfCounters {
+public:
+    PerfCounters() {
+        const std::array<std::pair<uint32_t, uint64_t>, kPerfCounterCount> events = {{
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D
+                                     | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                     | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        }};
+
+        int firstError = 0;
+        for (size_t i = 0; i < kPerfCounterCount; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = events[i].first;
+            attr.config = events[i].second;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fds_[i] < 0 && firstError == 0) {
+                firstError = errno;
+            }
+        }
+
+        if (firstError != 0) {
+            std::cerr << "note: some perf counters are unavailable (" << std::strerror(firstError)
+                      << "); they are reported as n/a. Check /proc/sys/kernel/perf_event_paranoid.\n";
+        }
+    }
+
+    ~PerfCounters() {
+        for (int fd : fds_) {
+            if (fd >= 0) close(fd);
+        }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    static PerfCounters& instance() {
+        static PerfCounters counters;
+        return counters;
+    }
+
+    void start() {
+        for (int fd : fds_) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    // Stops all counters and returns per-op values; unavailable counters are
+    // reported as a negative value.
+    std::array<double, kPerfCounterCount> stop(size_t iterations) {
+        std::array<double, kPerfCounterCount> perOp;
+        perOp.fill(-1.0);
+        for (size_t i = 0; i < kPerfCounterCount; ++i) {
+            if (fds_[i] < 0) continue;
+            ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t values[3] = {0, 0, 0}; // value, time_enabled, time_running
+            if (read(fds_[i], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)) || values[2] == 0) {
+                continue;
+            }
+            // Scale for multiplexing when the PMU has fewer slots than counters
+            double scaled = static_cast<double>(values[0])
+                * (static_cast<double>(values[1]) / static_cast<double>(values[2]));
+            perOp[i] = scaled / static_cast<double>(iterations);
+        }
+        return perOp;
+    }
+
+private:
+    std::array<int, kPerfCounterCount> fds_{};
+};
+
+#endif // BENCH_HAS_PERF_COUNTERS
+
 struct BenchResult {
     std::string name;
     double ns_per_op;
     size_t iterations;
+    double allocs_per_op = 0.0;
+    double bytes_per_op = 0.0;
+#ifdef BENCH_HAS_PERF_COUNTERS
+    std::array<double, kPerfCounterCount> counters_per_op{};
+#endif
 };
 
 inline BenchResult run_benchmark(const std::string& name, size_t iterations, std::function<void()> fn) {
@@ -24,18 +181,42 @@ inline BenchResult run_benchmark(const std::string& name, size_t iterations, std
         fn();
     }
 
+#ifdef BENCH_COUNT_ALLOCS
+    size_t allocs_before = detail::alloc_count.load(std::memory_order_relaxed);
+    size_t bytes_before = detail::alloc_bytes.load(std::memory_order_relaxed);
+#endif
+
+#ifdef BENCH_HAS_PERF_COUNTERS
+    PerfCounters& perf = PerfCounters::instance();
+    perf.start();
+#endif
+
     auto start = std::chrono::high_resolution_clock::now();
     for (size_t i = 0; i < iterations; ++i) {
         fn();
     }
     auto end = std::chrono::high_resolution_clock::now();
 
+#ifdef BENCH_HAS_PERF_COUNTERS
+    auto counters = perf.stop(iterations);
+#endif
+
     double total_ns = static_cast<double>(
         std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()
     );
     double ns_per_op = total_ns / static_cast<double>(iterations);
 
-    return {name, ns_per_op, iterations};
+    BenchResult result{name, ns_per_op, iterations};
+#ifdef BENCH_COUNT_ALLOCS
+    size_t allocs = detail::alloc_count.load(std::memory_order_relaxed) - allocs_before;
+    size_t bytes = detail::alloc_bytes.load(std::memory_order_relaxed) - bytes_before;
+    result.allocs_per_op = static_cast<double>(allocs) / static_cast<double>(iterations);
+    result.bytes_per_op = static_cast<double>(bytes) / static_cast<double>(iterations);
+#endif
+#ifdef BENCH_HAS_PERF_COUNTERS
+    result.counters_per_op = counters;
+#endif
+    return result;
 }
 
 inline void print_results(const std::vector<BenchResult>& results) {
@@ -45,19 +226,50 @@ inline void print_results(const std::vector<BenchResult>& results) {
         max_name = std::max(max_name, r.name.size());
     }
 
-    std::cout << std::string(max_name + 35, '-') << "\n";
+    size_t width = max_name + 35;
+#ifdef BENCH_COUNT_ALLOCS
+    width += 30;
+#endif
+#ifdef BENCH_HAS_PERF_COUNTERS
+    width += 14 * kPerfCounterCount;
+#endif
+
+    std::cout << std::string(width, '-') << "\n";
     std::cout << std::left << std::setw(static_cast<int>(max_name + 2)) << "Benchmark"
               << std::right << std::setw(15) << "ns/op"
-              << std::setw(15) << "iterations" << "\n";
-    std::cout << std::string(max_name + 35, '-') << "\n";
+              << std::setw(15) << "iterations";
+#ifdef BENCH_COUNT_ALLOCS
+    std::cout << std::setw(15) << "allocs/op" << std::setw(15) << "bytes/op";
+#endif
+#ifdef BENCH_HAS_PERF_COUNTERS
+    for (const char* counterName : kPerfCounterNames) {
+        std::cout << std::setw(14) << counterName;
+    }
+#endif
+    std::cout << "\n";
+    std::cout << std::string(width, '-') << "\n";
 
     for (const auto& r : results) {
         std::cout << std::left << std::setw(static_cast<int>(max_name + 2)) << r.name
                   << std::right << std::setw(15) << std::fixed << std::setprecision(1) << r.ns_per_op
-                  << std::setw(15) << r.iterations << "\n";
+                  << std::setw(15) << r.iterations;
+#ifdef BENCH_COUNT_ALLOCS
+        std::cout << std::setw(15) << std::setprecision(2) << r.allocs_per_op
+                  << std::setw(15) << std::setprecision(1) << r.bytes_per_op;
+#endif
+#ifdef BENCH_HAS_PERF_COUNTERS
+        for (double value : r.counters_per_op) {
+            if (value < 0.0) {
+                std::cout << std::setw(14) << "n/a";
+            } else {
+                std::cout << std::setw(14) << std::setprecision(2) << value;
+            }
+        }
+#endif
+        std::cout << "\n";
     }
 
-    std::cout << std::string(max_name + 35, '-') << "\n";
+    std::cout << std::string(width, '-') << "\n";
 }
 
 } // namespace bench
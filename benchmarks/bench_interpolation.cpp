@@ -43,6 +43,83 @@ int main() {
         volatile auto r = i18n.tr("no_placeholders");
     }));
 
+    // Typed placeholders vs. formatting each value into a temporary first
+    i18n::I18N typed;
+    typed.load({{"en", {
+        {"order_typed", "Order {0}: {1:number} items, {2:price}"},
+        {"order_plain", "Order {0}: {1} items, {2}"}
+    }}});
+    typed.setLocale("en");
+
+    // BM_TypedPlaceholders: {n:number}/{n:price} formatted into the output
+    results.push_back(bench::run_benchmark("TypedPlaceholders", ITERATIONS, [&]() {
+        volatile auto r = typed.trf("order_typed", {"A-17", 1250, 1234.5});
+    }));
+
+    // BM_FormatThenTr: the same message built from formatNumber/formatPrice strings
+    results.push_back(bench::run_benchmark("FormatThenTr", ITERATIONS, [&]() {
+        volatile auto r = typed.tr("order_plain", {"A-17", typed.formatNumber(1250), typed.formatPrice(1234.5)});
+    }));
+
+    // BM_TrfHtmlEscaped: same message escaped for HTML while it is rendered
+    results.push_back(bench::run_benchmark("TrfHtmlEscaped", ITERATIONS, [&]() {
+        volatile auto r = typed.trf("order_typed", {"<A&17>", 1250, 1234.5}, i18n::Escape::Html);
+    }));
+
+    // BM_TrfSegments: long template rendered as segments into a reused output
+    typed.load({{"en", {
+        {"notice", "Your subscription has been renewed. The next invoice, for {0:price}, will be sent to {1} "
+                   "at the start of the next billing period. No action is required on your part."}
+    }}});
+    typed.setLocale("en");
+    i18n::SegmentedOutput segments;
+    const std::string email = "ann@example.com";
+    results.push_back(bench::run_benchmark("TrfSegments", ITERATIONS, [&]() {
+        const i18n::FormatArg args[] = {49.95, email};
+        typed.trfSegments(segments, "notice", args);
+        volatile size_t n = segments.size();
+    }));
+
+    // BM_TrfConcatenated: same long template into a reused string
+    std::string concatenated;
+    results.push_back(bench::run_benchmark("TrfConcatenated", ITERATIONS, [&]() {
+        const i18n::FormatArg args[] = {49.95, email};
+        concatenated.clear();
+        typed.trfInto(concatenated, "notice", args);
+        volatile size_t n = concatenated.size();
+    }));
+
+    // BM_MsgDiscarded: lazy message that is filtered out before reaching a sink
+    results.push_back(bench::run_benchmark("MsgDiscarded", ITERATIONS, [&]() {
+        auto message = typed.msg("notice", 49.95, email);
+        volatile size_t n = message.args().size();
+    }));
+
+    // BM_TrfDiscarded: eagerly rendered message that is then thrown away
+    results.push_back(bench::run_benchmark("TrfDiscarded", ITERATIONS, [&]() {
+        volatile auto r = typed.trf("notice", {49.95, email});
+    }));
+
+#if defined(I18N_HAS_STD_FORMATTER) || defined(I18N_HAS_FMT_FORMATTER)
+#ifdef I18N_HAS_STD_FORMATTER
+    namespace fmt_ns = std;
+#else
+    namespace fmt_ns = fmt;
+#endif
+    // BM_FormatMessage: message embedded in a format string, rendered in place
+    std::string formatted;
+    results.push_back(bench::run_benchmark("FormatMessage", ITERATIONS, [&]() {
+        formatted.clear();
+        fmt_ns::format_to(std::back_inserter(formatted), "{}: {}", "Billing", typed.msg("notice", 49.95, email));
+    }));
+
+    // BM_FormatTrString: same, going through a temporary trf() string
+    results.push_back(bench::run_benchmark("FormatTrString", ITERATIONS, [&]() {
+        formatted.clear();
+        fmt_ns::format_to(std::back_inserter(formatted), "{}: {}", "Billing", typed.trf("notice", {49.95, email}));
+    }));
+#endif
+
     std::cout << "\n=== Interpolation Benchmarks ===\n\n";
     bench::print_results(results);
 
@@ -1,6 +1,7 @@
 #include "bench_harness.h"
 #include "i18ncpp.h"
 #include <string>
+#include <vector>
 
 static std::string fixturesDir() {
     return FIXTURES_DIR;
@@ -45,11 +46,29 @@ int main() {
         }));
     }
 
+    // BM_TrMissingEverywhere: key absent from every locale of the chain
+    results.push_back(bench::run_benchmark("TrMissingEverywhere", ITERATIONS, [&]() {
+        volatile auto r = i18n.tr("rollout.unreleased_banner");
+    }));
+
     // BM_TrPlural: plural form selection
     results.push_back(bench::run_benchmark("TrPlural", ITERATIONS, [&]() {
         volatile auto r = i18n.trPlural("items_plural", 5);
     }));
 
+    // BM_TrPluralManyCounts: a different count on every call, as in a feed
+    int nextCount = 0;
+    results.push_back(bench::run_benchmark("TrPluralManyCounts", ITERATIONS, [&]() {
+        nextCount = (nextCount + 1) % 100000;
+        volatile auto r = i18n.trPlural("items_plural", nextCount);
+    }));
+
+    // BM_TrOrdinalManyCounts: ordinal forms, a different count on every call
+    results.push_back(bench::run_benchmark("TrOrdinalManyCounts", ITERATIONS, [&]() {
+        nextCount = (nextCount + 1) % 100000;
+        volatile auto r = i18n.trOrdinal("items_plural", nextCount);
+    }));
+
     // BM_KeyExists: existence check
     results.push_back(bench::run_benchmark("KeyExists", ITERATIONS, [&]() {
         volatile auto r = i18n.keyExists("greeting");
@@ -60,6 +79,95 @@ int main() {
         volatile auto r = i18n.keyExists("nonexistent.key");
     }));
 
+    // BM_TrLargeCatalog: scattered lookups over a 50k-key catalog, so the
+    // translation cache and locale tables no longer fit in L1/L2
+    {
+        const size_t keyCount = 50000;
+        nlohmann::json data;
+        std::vector<std::string> keys;
+        keys.reserve(keyCount);
+        for (size_t k = 0; k < keyCount; ++k) {
+            keys.push_back("section_" + std::to_string(k / 100) + ".item_" + std::to_string(k % 100));
+            data["en"]["section_" + std::to_string(k / 100)]["item_" + std::to_string(k % 100)] = "Value";
+        }
+        i18n::I18N i18n_large;
+        i18n_large.load(data);
+        i18n_large.setLocale("en");
+        size_t next = 0;
+        results.push_back(bench::run_benchmark("TrLargeCatalog", ITERATIONS, [&]() {
+            next = (next + 7919) % keyCount;
+            volatile auto r = i18n_large.tr(keys[next]);
+        }));
+
+        // BM_ForEachKeyWithPrefix / BM_TrSubtree: one 100-key section of the
+        // same catalog, enumerated and translated through the key trie
+        results.push_back(bench::run_benchmark("ForEachKeyWithPrefix", ITERATIONS / 10, [&]() {
+            size_t count = 0;
+            i18n_large.forEachKeyWithPrefix("section_250", [&](std::string_view) { ++count; });
+            volatile size_t r = count;
+        }));
+        results.push_back(bench::run_benchmark("TrSubtree", ITERATIONS / 10, [&]() {
+            volatile auto r = i18n_large.trSubtree("section_250").size();
+        }));
+
+        // BM_RenderBundleCached: repeat request for the same section bundle
+        results.push_back(bench::run_benchmark("RenderBundleCached", ITERATIONS, [&]() {
+            volatile auto r = i18n_large.renderBundle("section_250").size();
+        }));
+
+        // BM_KeyExistsMissingLarge: misses against the same catalog; the key
+        // filter rejects most of them without probing the key index
+        std::vector<std::string> missing;
+        missing.reserve(1000);
+        for (size_t k = 0; k < 1000; ++k) {
+            missing.push_back("section_" + std::to_string(k % 500) + ".missing_" + std::to_string(k));
+        }
+        size_t nextMissing = 0;
+        results.push_back(bench::run_benchmark("KeyExistsMissingLarge", ITERATIONS, [&]() {
+            nextMissing = (nextMissing + 1) % missing.size();
+            volatile auto r = i18n_large.keyExists(missing[nextMissing]);
+        }));
+    }
+
+    // BM_TrBatch16: 16 keys resolved in one trBatch call (ns/op is per batch)
+    {
+        std::vector<i18n::KeyRequest> page = {
+            {"greeting"}, {"farewell"}, {"menu.file.open"}, {"menu.file.save"},
+            {"menu.file.close"}, {"menu.edit.copy"}, {"menu.edit.paste"}, {"deep.nested.key"},
+            {"only_in_en"}, {"no_placeholders"}, {"items_plural"}, {"greeting"},
+            {"items.0"}, {"items.1"}, {"items.2"}, {"nonexistent.key"},
+        };
+        i18n::BatchOutput out;
+        results.push_back(bench::run_benchmark("TrBatch16", ITERATIONS, [&]() {
+            i18n.trBatch(page, out);
+        }));
+    }
+
+    // BM_TrBatch16Chain3 / Materialized: same page resolved from ru through
+    // fr to en, walking the chain vs. reading materializeFallbacks() tables
+    {
+        std::vector<i18n::KeyRequest> page = {
+            {"greeting"}, {"farewell"}, {"menu.file.open"}, {"menu.file.save"},
+            {"menu.file.close"}, {"menu.edit.copy"}, {"menu.edit.paste"}, {"deep.nested.key"},
+            {"only_in_en"}, {"no_placeholders"}, {"items_plural"}, {"greeting"},
+            {"items.0"}, {"items.1"}, {"items.2"}, {"nonexistent.key"},
+        };
+        i18n::I18N i18n_chain;
+        i18n_chain.loadLocale("en", (fixturesDir() + "/en.json").c_str());
+        i18n_chain.loadLocale("fr", (fixturesDir() + "/fr.json").c_str());
+        i18n_chain.loadLocale("ru", (fixturesDir() + "/ru.json").c_str());
+        i18n_chain.setLocale(std::vector<std::string>{"ru", "fr"});
+        i18n_chain.setFallbackLocale("en");
+        i18n::BatchOutput out;
+        results.push_back(bench::run_benchmark("TrBatch16Chain3", ITERATIONS, [&]() {
+            i18n_chain.trBatch(page, out);
+        }));
+        i18n_chain.materializeFallbacks();
+        results.push_back(bench::run_benchmark("TrBatch16Chain3Materialized", ITERATIONS, [&]() {
+            i18n_chain.trBatch(page, out);
+        }));
+    }
+
     std::cout << "\n=== Lookup Benchmarks ===\n\n";
     bench::print_results(results);
 
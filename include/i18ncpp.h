@@ -20,6 +20,45 @@
 #include <type_traits>
 #include <algorithm>
 #include <cctype>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <chrono>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define I18N_HAS_SSE2 1
+#endif
+
+// Message formatters: std::formatter when <format> is available, otherwise
+// fmt::formatter (the library itself falls back to {fmt} the same way)
+#if __has_include(<version>)
+    #include <version>
+#endif
+#if defined(__cpp_lib_format) && (__cpp_lib_format >= 201907L)
+    #include <format>
+    #define I18N_HAS_STD_FORMATTER 1
+#elif __has_include(<fmt/format.h>)
+    #include <fmt/format.h>
+#endif
+#if defined(FMT_VERSION)
+    #define I18N_HAS_FMT_FORMATTER 1
+#endif
+
+#if __has_include(<sys/uio.h>)
+    #include <sys/uio.h>
+    #define I18N_HAS_IOVEC 1
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define I18N_PREFETCH(addr) __builtin_prefetch(addr)
+#elif defined(I18N_HAS_SSE2)
+    #define I18N_PREFETCH(addr) _mm_prefetch(reinterpret_cast<const char*>(addr), _MM_HINT_T0)
+#else
+    #define I18N_PREFETCH(addr) ((void)(addr))
+#endif
 
 namespace i18n {
 
@@ -42,6 +81,269 @@ struct StringEqual {
     }
 };
 
+/// Open-addressing hash table keyed by `std::string`, used for the catalog key
+/// index, load-time staging and the memoization caches.
+///
+/// Entries live densely in insertion order; a Swiss-table style index maps
+/// hashes to entry positions. Each index slot has a control byte holding 7
+/// bits of the hash (or `kEmpty`), and slots are probed in aligned groups of
+/// 16 so a whole group is matched with one SSE2 compare (scalar loop on other
+/// targets). The full hash is stored with each entry, so control-byte
+/// collisions are rejected without a string compare, and growth never rehashes
+/// keys. Entries are never erased individually; `clear()` drops everything but
+/// keeps capacity for reuse.
+template<typename V>
+class FlatStringMap {
+public:
+    struct Entry {
+        std::string key;
+        V value;
+        size_t hash = 0;
+    };
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    static size_t hashOf(std::string_view key) noexcept {
+        return StringHash{}(key);
+    }
+
+    size_t size() const noexcept { return entries_.size(); }
+    bool empty() const noexcept { return entries_.empty(); }
+
+    auto begin() noexcept { return entries_.begin(); }
+    auto end() noexcept { return entries_.end(); }
+    auto begin() const noexcept { return entries_.begin(); }
+    auto end() const noexcept { return entries_.end(); }
+
+    const Entry& entryAt(size_t index) const noexcept { return entries_[index]; }
+    Entry& entryAt(size_t index) noexcept { return entries_[index]; }
+
+    void clear() noexcept {
+        entries_.clear();
+        if (!ctrl_.empty()) {
+            std::memset(ctrl_.data(), kEmpty, ctrl_.size());
+        }
+    }
+
+    void reserve(size_t count) {
+        entries_.reserve(count);
+        size_t needed = kGroupWidth;
+        while (needed * 7 / 8 < count) {
+            needed *= 2;
+        }
+        if (needed > ctrl_.size()) {
+            rehash(needed);
+        }
+    }
+
+    /// Releases growth slack once a table is fully built: trims the entry
+    /// array to its size and the index to the smallest capacity that keeps
+    /// the load factor at or below 7/8.
+    void shrinkToFit() {
+        entries_.shrink_to_fit();
+        size_t needed = kGroupWidth;
+        while (needed * 7 / 8 < entries_.size()) {
+            needed *= 2;
+        }
+        if (needed < ctrl_.size()) {
+            rehash(needed);
+            ctrl_.shrink_to_fit();
+            slots_.shrink_to_fit();
+        }
+    }
+
+    /// Position of `key` in insertion order, or `npos`.
+    size_t findIndex(std::string_view key, size_t hash) const noexcept {
+        if (ctrl_.empty()) {
+            return npos;
+        }
+        const int8_t h2 = static_cast<int8_t>(hash & 0x7F);
+        size_t group = (hash >> 7) & groupMask_;
+        for (size_t step = 1;; ++step) {
+            const size_t base = group * kGroupWidth;
+            uint32_t match = matchByte(base, h2);
+            while (match != 0) {
+                const size_t slot = base + static_cast<size_t>(std::countr_zero(match));
+                const Entry& entry = entries_[slots_[slot]];
+                if (entry.hash == hash && entry.key == key) {
+                    return slots_[slot];
+                }
+                match &= match - 1;
+            }
+            // No erasure, so an empty slot in the group terminates the probe
+            if (matchByte(base, kEmpty) != 0) {
+                return npos;
+            }
+            group = (group + step) & groupMask_; // triangular probing visits every group
+        }
+    }
+
+    size_t findIndex(std::string_view key) const noexcept {
+        return findIndex(key, hashOf(key));
+    }
+
+    V* find(std::string_view key, size_t hash) noexcept {
+        size_t index = findIndex(key, hash);
+        return index == npos ? nullptr : &entries_[index].value;
+    }
+
+    const V* find(std::string_view key, size_t hash) const noexcept {
+        size_t index = findIndex(key, hash);
+        return index == npos ? nullptr : &entries_[index].value;
+    }
+
+    V* find(std::string_view key) noexcept { return find(key, hashOf(key)); }
+    const V* find(std::string_view key) const noexcept { return find(key, hashOf(key)); }
+
+    /// Issues a software prefetch for the index group a lookup of `hash`
+    /// will probe first. Used to overlap independent lookups.
+    void prefetch(size_t hash) const noexcept {
+        if (ctrl_.empty()) {
+            return;
+        }
+        const size_t base = ((hash >> 7) & groupMask_) * kGroupWidth;
+        I18N_PREFETCH(ctrl_.data() + base);
+        I18N_PREFETCH(slots_.data() + base);
+    }
+
+    /// Returns the value for `key`, inserting a value-initialized one if absent.
+    /// Accepts `std::string&&` (moved in), `std::string_view`, `const char*`.
+    template<typename K>
+    V& operator[](K&& key) {
+        const std::string_view view(key);
+        const size_t hash = hashOf(view);
+        size_t index = findIndex(view, hash);
+        if (index == npos) {
+            index = insertNew(std::string(std::forward<K>(key)), hash);
+        }
+        return entries_[index].value;
+    }
+
+    /// Heap bytes owned by the table structure (entries, index, control
+    /// bytes), excluding out-of-line string storage of keys and values.
+    size_t memoryUsage() const noexcept {
+        return entries_.capacity() * sizeof(Entry)
+            + slots_.capacity() * sizeof(uint32_t)
+            + ctrl_.capacity();
+    }
+
+private:
+    static constexpr size_t kGroupWidth = 16;
+    static constexpr int8_t kEmpty = static_cast<int8_t>(-128);
+
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> slots_;
+    std::vector<int8_t> ctrl_;
+    size_t groupMask_ = 0;
+
+    uint32_t matchByte(size_t base, int8_t byte) const noexcept {
+#ifdef I18N_HAS_SSE2
+        const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl_.data() + base));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(byte))));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kGroupWidth; ++i) {
+            mask |= static_cast<uint32_t>(ctrl_[base + i] == byte) << i;
+        }
+        return mask;
+#endif
+    }
+
+    void placeSlot(size_t hash, uint32_t index) noexcept {
+        size_t group = (hash >> 7) & groupMask_;
+        for (size_t step = 1;; ++step) {
+            const size_t base = group * kGroupWidth;
+            uint32_t empty = matchByte(base, kEmpty);
+            if (empty != 0) {
+                const size_t slot = base + static_cast<size_t>(std::countr_zero(empty));
+                ctrl_[slot] = static_cast<int8_t>(hash & 0x7F);
+                slots_[slot] = index;
+                return;
+            }
+            group = (group + step) & groupMask_;
+        }
+    }
+
+    void rehash(size_t capacity) {
+        ctrl_.assign(capacity, kEmpty);
+        slots_.assign(capacity, 0);
+        groupMask_ = capacity / kGroupWidth - 1;
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            placeSlot(entries_[i].hash, static_cast<uint32_t>(i));
+        }
+    }
+
+    size_t insertNew(std::string&& key, size_t hash) {
+        // Keep the index at most 7/8 full
+        if ((entries_.size() + 1) * 8 > ctrl_.size() * 7) {
+            rehash(ctrl_.empty() ? kGroupWidth : ctrl_.size() * 2);
+        }
+        const size_t index = entries_.size();
+        entries_.push_back(Entry{std::move(key), V{}, hash});
+        placeSlot(hash, static_cast<uint32_t>(index));
+        return index;
+    }
+};
+
+/// Blocked Bloom filter over key hashes, consulted before probing the key
+/// index so that keys which were never loaded are rejected without touching
+/// the table. Each key sets four bits inside one 64-bit word chosen by its
+/// hash, so a query is a single load and mask test. Sized at about 16 bits
+/// per key (under 1% false positives); never yields false negatives.
+class KeyFilter {
+public:
+    /// Empties the filter and sizes it for `count` keys.
+    void reset(size_t count) {
+        size_t wordCount = 1;
+        while (wordCount * 64 < count * kBitsPerKey) {
+            wordCount *= 2;
+        }
+        words_.assign(wordCount, 0);
+        wordShift_ = 64 - static_cast<unsigned>(std::countr_zero(wordCount));
+    }
+
+    void insert(size_t hash) noexcept {
+        const uint64_t mixed = mix(hash);
+        words_[wordIndex(mixed)] |= bitMask(mixed);
+    }
+
+    bool mayContain(size_t hash) const noexcept {
+        if (words_.empty()) {
+            return false;
+        }
+        const uint64_t mixed = mix(hash);
+        const uint64_t mask = bitMask(mixed);
+        return (words_[wordIndex(mixed)] & mask) == mask;
+    }
+
+    void clear() noexcept { words_.clear(); }
+
+    size_t memoryUsage() const noexcept { return words_.capacity() * sizeof(uint64_t); }
+
+private:
+    static constexpr size_t kBitsPerKey = 16;
+
+    std::vector<uint64_t> words_;
+    unsigned wordShift_ = 64;
+
+    // The key index uses the low hash bits; remix so the filter's bit
+    // choices are independent of the index's group and control byte.
+    static uint64_t mix(size_t hash) noexcept {
+        return static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+    }
+
+    size_t wordIndex(uint64_t mixed) const noexcept {
+        return wordShift_ >= 64 ? 0 : static_cast<size_t>(mixed >> wordShift_);
+    }
+
+    static uint64_t bitMask(uint64_t mixed) noexcept {
+        return (uint64_t{1} << (mixed & 63))
+             | (uint64_t{1} << ((mixed >> 6) & 63))
+             | (uint64_t{1} << ((mixed >> 12) & 63))
+             | (uint64_t{1} << ((mixed >> 18) & 63));
+    }
+};
+
 class I18NError : public std::runtime_error {
 public:
     using std::runtime_error::runtime_error;
@@ -85,6 +387,116 @@ struct NumberConfig {
     NumberConfig& operator=(const NumberConfig&) = default;
 };
 
+// formatCompact(): suffixes[i] abbreviates 10^(3 * (i + 1)) (thousands,
+// millions, ...); an empty suffix leaves that magnitude written out in full.
+// Up to fract_digits (0-3) digits are kept, trailing zeros dropped.
+struct CompactConfig {
+    std::vector<std::string> suffixes = {"K", "M", "B", "T"};
+    int fract_digits = 1;
+
+    CompactConfig() = default;
+    CompactConfig(CompactConfig&&) noexcept = default;
+    CompactConfig& operator=(CompactConfig&&) noexcept = default;
+    CompactConfig(const CompactConfig&) = default;
+    CompactConfig& operator=(const CompactConfig&) = default;
+};
+
+// formatPercent(): prefix and suffix around the scaled number, which uses the
+// NumberConfig separators and signs with exactly fract_digits (0-9) digits
+struct PercentConfig {
+    std::string prefix = "";
+    std::string suffix = "%";
+    int fract_digits = 0;
+
+    PercentConfig() = default;
+    PercentConfig(PercentConfig&&) noexcept = default;
+    PercentConfig& operator=(PercentConfig&&) noexcept = default;
+    PercentConfig(const PercentConfig&) = default;
+    PercentConfig& operator=(const PercentConfig&) = default;
+};
+
+// formatRelative(): per unit ("second" ... "year"), templates for each plural
+// category ("one", "few", "other", ...) with {0} for the count. A category
+// without a template uses "other".
+struct RelativeTimeConfig {
+    std::string now = "now";
+    std::map<std::string, std::map<std::string, std::string, std::less<>>, std::less<>> past = {
+        {"second", {{"one", "{0} second ago"}, {"other", "{0} seconds ago"}}},
+        {"minute", {{"one", "{0} minute ago"}, {"other", "{0} minutes ago"}}},
+        {"hour", {{"one", "{0} hour ago"}, {"other", "{0} hours ago"}}},
+        {"day", {{"one", "{0} day ago"}, {"other", "{0} days ago"}}},
+        {"week", {{"one", "{0} week ago"}, {"other", "{0} weeks ago"}}},
+        {"month", {{"one", "{0} month ago"}, {"other", "{0} months ago"}}},
+        {"year", {{"one", "{0} year ago"}, {"other", "{0} years ago"}}}
+    };
+    std::map<std::string, std::map<std::string, std::string, std::less<>>, std::less<>> future = {
+        {"second", {{"one", "in {0} second"}, {"other", "in {0} seconds"}}},
+        {"minute", {{"one", "in {0} minute"}, {"other", "in {0} minutes"}}},
+        {"hour", {{"one", "in {0} hour"}, {"other", "in {0} hours"}}},
+        {"day", {{"one", "in {0} day"}, {"other", "in {0} days"}}},
+        {"week", {{"one", "in {0} week"}, {"other", "in {0} weeks"}}},
+        {"month", {{"one", "in {0} month"}, {"other", "in {0} months"}}},
+        {"year", {{"one", "in {0} year"}, {"other", "in {0} years"}}}
+    };
+
+    RelativeTimeConfig() = default;
+    RelativeTimeConfig(RelativeTimeConfig&&) noexcept = default;
+    RelativeTimeConfig& operator=(RelativeTimeConfig&&) noexcept = default;
+    RelativeTimeConfig(const RelativeTimeConfig&) = default;
+    RelativeTimeConfig& operator=(const RelativeTimeConfig&) = default;
+};
+
+// formatList(): CLDR-style patterns with {0} followed by {1}. Two items use
+// `pair`; longer lists join the first two with `start`, the last two with
+// `end` and the ones between with `middle`.
+struct ListConfig {
+    std::string pair = "{0} and {1}";
+    std::string start = "{0}, {1}";
+    std::string middle = "{0}, {1}";
+    std::string end = "{0}, and {1}";
+
+    ListConfig() = default;
+    ListConfig(ListConfig&&) noexcept = default;
+    ListConfig& operator=(ListConfig&&) noexcept = default;
+    ListConfig(const ListConfig&) = default;
+    ListConfig& operator=(const ListConfig&) = default;
+};
+
+// formatDuration(): per unit ("day", "hour", "minute", "second"), templates
+// for each plural category with {0} for the count ("other" is the fallback),
+// joined by `separator`. max_units > 0 keeps only that many leading units.
+struct DurationConfig {
+    std::map<std::string, std::map<std::string, std::string, std::less<>>, std::less<>> units = {
+        {"day", {{"other", "{0} d"}}},
+        {"hour", {{"other", "{0} h"}}},
+        {"minute", {{"other", "{0} min"}}},
+        {"second", {{"other", "{0} s"}}}
+    };
+    std::string separator = " ";
+    int max_units = 0;
+
+    DurationConfig() = default;
+    DurationConfig(DurationConfig&&) noexcept = default;
+    DurationConfig& operator=(DurationConfig&&) noexcept = default;
+    DurationConfig(const DurationConfig&) = default;
+    DurationConfig& operator=(const DurationConfig&) = default;
+};
+
+// formatOrdinal(): templates for each ordinal plural category ("one" for
+// 1st and 21st in English, "two", "few", "other", ...) with {0} for the
+// number. A category without a template uses "other". When empty, locales
+// with English ordinal rules get "{0}st", "{0}nd", "{0}rd" and "{0}th", and
+// other locales the bare number.
+struct OrdinalConfig {
+    std::map<std::string, std::string, std::less<>> forms;
+
+    OrdinalConfig() = default;
+    OrdinalConfig(OrdinalConfig&&) noexcept = default;
+    OrdinalConfig& operator=(OrdinalConfig&&) noexcept = default;
+    OrdinalConfig(const OrdinalConfig&) = default;
+    OrdinalConfig& operator=(const OrdinalConfig&) = default;
+};
+
 struct DateTimeConfig {
     std::string long_time = "%H:%M:%S";
     std::string short_time = "%H:%M";
@@ -102,7 +514,17 @@ struct DateTimeConfig {
 
 struct FormatConfig {
     CurrencyConfig currency;
+    // Formats for other ISO 4217 codes, used by formatPrice(amount, code).
+    // Each entry starts from `currency` and overrides the fields it gives;
+    // configuring `currency` again drops the entries derived from it.
+    std::map<std::string, CurrencyConfig, std::less<>> currencies;
     NumberConfig number;
+    CompactConfig compact;
+    PercentConfig percent;
+    RelativeTimeConfig relative;
+    ListConfig list;
+    DurationConfig duration;
+    OrdinalConfig ordinal;
     DateTimeConfig date_time;
     std::vector<std::string> short_month_names = {
         "Jan", "Feb", "Mar", "Apr", "May", "Jun",
@@ -127,18 +549,222 @@ struct FormatConfig {
     FormatConfig& operator=(const FormatConfig&) = default;
 };
 
+/// Output context for `trf()`. Catalog text is escaped once per key and mode
+/// when its template is compiled; arguments are escaped as they are written.
+///   - `Html`: `& < > " '` become entities
+///   - `Json`: contents of a JSON string literal (quotes not added)
+///   - `Url`: percent-encoding of everything but `A-Z a-z 0-9 - _ . ~`
+enum class Escape : uint8_t {
+    None,
+    Html,
+    Json,
+    Url
+};
+
+/// Argument of `trf()`: a string, a number or a point in time, kept raw so
+/// typed placeholders can format it straight into the output. Strings and
+/// `std::tm` are referenced, not copied, and must outlive the call.
+class FormatArg {
+public:
+    enum class Kind : uint8_t {
+        String,
+        Integer,
+        Float,
+        Time,      // std::tm
+        Timestamp  // std::time_t, converted with the local time zone
+    };
+
+    FormatArg(std::string_view text) noexcept : kind_(Kind::String), text_(text) {}
+    FormatArg(const std::string& text) noexcept : kind_(Kind::String), text_(text) {}
+    FormatArg(const char* text) noexcept : kind_(Kind::String), text_(text) {}
+    FormatArg(bool value) noexcept : kind_(Kind::String), text_(value ? "true" : "false") {}
+    template<typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+    FormatArg(T value) noexcept : kind_(Kind::Integer), integer_(static_cast<int64_t>(value)) {}
+    template<typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+    FormatArg(T value) noexcept : kind_(Kind::Float), float_(static_cast<double>(value)) {}
+    FormatArg(const std::tm& time) noexcept : kind_(Kind::Time), time_(&time) {}
+    FormatArg(std::chrono::system_clock::time_point time) noexcept
+        : kind_(Kind::Timestamp), integer_(static_cast<int64_t>(std::chrono::system_clock::to_time_t(time))) {}
+
+    Kind kind() const noexcept { return kind_; }
+    std::string_view text() const noexcept { return text_; }
+    int64_t integer() const noexcept { return integer_; }
+    double number() const noexcept { return kind_ == Kind::Float ? float_ : static_cast<double>(integer_); }
+    const std::tm* time() const noexcept { return time_; }
+
+private:
+    Kind kind_;
+    std::string_view text_;
+    int64_t integer_ = 0;
+    double float_ = 0.0;
+    const std::tm* time_ = nullptr;
+};
+
+/// One entry of a `trBatch()` call. `params` follow the same rules as `tr()`.
+struct KeyRequest {
+    std::string_view key;
+    std::span<const std::string> params = {};
+};
+
+/// Output of `trBatch()` and `formatRelativeBatch()`. All results are written back to back into a
+/// single arena string; entry `i` is an (offset, length) slice of that arena
+/// in request order. Reusing one `BatchOutput` across calls reuses its
+/// capacity. Views returned by `operator[]` are invalidated by the next
+/// `trBatch()` call on this output.
+class BatchOutput {
+public:
+    std::string_view operator[](size_t index) const noexcept {
+        const Slice& slice = slices_[index];
+        return std::string_view(arena_).substr(slice.offset, slice.length);
+    }
+
+    size_t size() const noexcept { return slices_.size(); }
+    bool empty() const noexcept { return slices_.empty(); }
+    const std::string& arena() const noexcept { return arena_; }
+
+    void clear() noexcept {
+        arena_.clear();
+        slices_.clear();
+    }
+
+private:
+    friend class I18N;
+
+    struct Slice {
+        size_t offset = 0;
+        size_t length = 0;
+    };
+
+    std::string arena_;
+    std::vector<Slice> slices_;
+};
+
+/// Output of `trfSegments()`: the rendered message as an ordered list of byte
+/// ranges, for scatter-gather writes. Literal text points into the catalog
+/// (or the compiled escaped template) and unescaped string arguments into the
+/// caller's strings; formatted values, padding, escaped arguments and a
+/// missing key are written to an internal buffer. `trfSegmentsInto()` and
+/// `Message::appendTo()` add to the segments already held. Views stay valid
+/// until the next `trfSegments()` or `clear()` on this output, the next
+/// catalog or locale change, or the end of the arguments' lifetime, whichever
+/// comes first. Reusing one output across calls reuses its capacity.
+class SegmentedOutput {
+public:
+    std::string_view operator[](size_t index) const noexcept {
+        const Segment& segment = segments_[index];
+        return std::string_view(segment.data ? segment.data : buffer_.data() + segment.offset, segment.length);
+    }
+
+    size_t size() const noexcept { return segments_.size(); }
+    bool empty() const noexcept { return segments_.empty(); }
+
+    // Total bytes across all segments
+    size_t byteSize() const noexcept {
+        size_t total = 0;
+        for (const Segment& segment : segments_) {
+            total += segment.length;
+        }
+        return total;
+    }
+
+    // Concatenates the segments (for callers that need one string after all)
+    std::string str() const {
+        std::string result;
+        result.reserve(byteSize());
+        for (size_t i = 0; i < segments_.size(); ++i) {
+            result.append((*this)[i]);
+        }
+        return result;
+    }
+
+#ifdef I18N_HAS_IOVEC
+    // Fills `iov` with one entry per segment, ready for writev()
+    void toIovecs(std::vector<iovec>& iov) const {
+        iov.resize(segments_.size());
+        for (size_t i = 0; i < segments_.size(); ++i) {
+            const std::string_view view = (*this)[i];
+            iov[i].iov_base = const_cast<char*>(view.data());
+            iov[i].iov_len = view.size();
+        }
+    }
+#endif
+
+    void clear() noexcept {
+        buffer_.clear();
+        segments_.clear();
+    }
+
+private:
+    friend class I18N;
+
+    // `data` is nullptr for bytes held in buffer_ at `offset`; the buffer may
+    // grow while rendering, so those are resolved on access
+    struct Segment {
+        const char* data = nullptr;
+        size_t offset = 0;
+        size_t length = 0;
+    };
+
+    std::string buffer_;
+    std::vector<Segment> segments_;
+
+    void appendView(std::string_view view) {
+        if (view.empty()) {
+            return;
+        }
+        if (!segments_.empty() && segments_.back().data && segments_.back().data + segments_.back().length == view.data()) {
+            segments_.back().length += view.size();
+            return;
+        }
+        segments_.push_back(Segment{view.data(), 0, view.size()});
+    }
+
+    // Records buffer_ bytes from `start` to the end as a segment, merged with
+    // the previous one when contiguous
+    void commitBuffer(size_t start) {
+        const size_t length = buffer_.size() - start;
+        if (length == 0) {
+            return;
+        }
+        if (!segments_.empty() && !segments_.back().data && segments_.back().offset + segments_.back().length == start) {
+            segments_.back().length += length;
+            return;
+        }
+        segments_.push_back(Segment{nullptr, start, length});
+    }
+};
+
+/// Output format of `I18N::renderBundle()`.
+///   - `Json`: one flat object mapping full dotted keys to translations, in
+///     key order, e.g. `{"settings.title":"Settings"}`.
+///   - `Binary`: the bytes `I18B`, a format version byte (1), the entry
+///     count, then for each entry its key and its translation, each written
+///     as a byte length followed by the bytes. Count and lengths are unsigned
+///     LEB128 varints.
+enum class BundleFormat {
+    Json,
+    Binary
+};
+
+template<size_t N>
+class Message;
+
 /// Internationalization library supporting translation, plural forms,
 /// number/currency/date formatting, and positional/named/formatted interpolation.
 ///
 /// \warning **This class is NOT thread-safe, not even for `const` methods.**
 /// The following members are `mutable` and written on every call:
-///   - `formatCache_` / `translationCache_` — memoization caches, written on cache miss
-///   - `interpolateBuf_` / `interpolateBuf2_` / `extendedParamsBuf_` — scratch buffers,
+///   - `formatCache_` / `translationCache_` / `pluralCache_` / `templateCache_` —
+///     memoization caches, written on cache miss
+///   - `interpolateBuf_` / `interpolateBuf2_` — scratch buffers,
 ///     written on every interpolation call
+///   - `cacheKeyBuf_` — scratch buffer for cache key construction, written on
+///     every cached call so that cache hits do not allocate
+///   - `bundleCache_` — rendered `renderBundle()` output, written on cache miss
 ///
 /// Calling any method (including `tr()`, `trPlural()`, `format*()`) on a shared
 /// instance from multiple threads is a data race and will cause UB — typically
-/// segfault from corrupted `unordered_map` bucket pointers, not merely stale data.
+/// segfault from corrupted hash table storage, not merely stale data.
 ///
 /// Valid usage patterns:
 ///   1. Create one `I18N` instance per thread.
@@ -183,7 +809,18 @@ public:
     
     std::string tr(std::string_view key) const;
     std::string tr(std::string_view key, std::span<const std::string> params) const;
-    std::string tr(std::string_view key, std::initializer_list<std::string> params) const;
+    std::string tr(std::string_view key, std::span<const std::string_view> params) const;
+    std::string tr(std::string_view key, std::initializer_list<std::string_view> params) const;
+
+    // Pre-string_view overload, kept for source compatibility: lists of
+    // std::string (or of types only convertible to std::string) and named
+    // std::initializer_list<std::string> variables still bind here. A
+    // template so that a list of literals, which converts equally well to
+    // both, resolves to the std::string_view overload above.
+    template<typename = void>
+    std::string tr(std::string_view key, std::initializer_list<std::string> params) const {
+        return tr(key, std::span<const std::string>(params.begin(), params.size()));
+    }
     
     template<typename... Args>
     std::string trv(std::string_view key, const Args&... args) const {
@@ -192,57 +829,520 @@ public:
     
     std::string trPlural(std::string_view key, int count) const;
     std::string trPlural(std::string_view key, int count, std::span<const std::string> params) const;
-    std::string trPlural(std::string_view key, int count, std::initializer_list<std::string> params) const;
+    std::string trPlural(std::string_view key, int count, std::span<const std::string_view> params) const;
+    std::string trPlural(std::string_view key, int count, std::initializer_list<std::string_view> params) const;
+
+    // See tr(key, std::initializer_list<std::string>)
+    template<typename = void>
+    std::string trPlural(std::string_view key, int count, std::initializer_list<std::string> params) const {
+        return trPlural(key, count, std::span<const std::string>(params.begin(), params.size()));
+    }
     
     template<typename... Args>
     std::string trPluralv(std::string_view key, int count, const Args&... args) const {
         return trPlural(key, count, argsToStrings(args...));
     }
+
+    // trPlural() with the locale's ordinal categories instead of its cardinal
+    // ones: in English "key.one" covers 1, 21, 31 ..., "key.two" 2, 22 ...,
+    // "key.few" 3, 23 ... and "key.other" the rest (11, 12, 13 included).
+    // Same fallbacks, exact-count forms and caching as trPlural().
+    std::string trOrdinal(std::string_view key, int n) const;
+    std::string trOrdinal(std::string_view key, int n, std::span<const std::string> params) const;
+    std::string trOrdinal(std::string_view key, int n, std::span<const std::string_view> params) const;
+    std::string trOrdinal(std::string_view key, int n, std::initializer_list<std::string_view> params) const;
     
+    // Translation with typed placeholders, compiled once per key and chain:
+    //   {0} / {}             the argument as is (numbers in shortest form)
+    //   {0:number}           formatNumber() with the active NumberConfig
+    //   {1:price}            formatPrice() with the active CurrencyConfig;
+    //                        {1:price:EUR} formats in that ISO 4217 currency
+    //   {2:date}             formatDate(); {2:date:short_date} names a
+    //                        DateTimeConfig pattern, or gives a literal one
+    //   {0:compact}          formatCompact()
+    //   {0:percent}          formatPercent()
+    //   {0:ordinal}          formatOrdinal()
+    //   {0,8:number} {1,-6}  pad to a width in bytes, right (positive) or
+    //                        left (negative) aligned
+    // Formatted values are written straight into the result. A key that does
+    // not resolve returns the key itself. With an `escape` mode the whole
+    // output is escaped for that context (padding is applied before escaping).
+    std::string trf(std::string_view key, std::initializer_list<FormatArg> args, Escape escape = Escape::None) const;
+    std::string trf(std::string_view key, std::span<const FormatArg> args, Escape escape = Escape::None) const;
+    // Same as trf(), appending to `out` so a reused buffer does not allocate
+    void trfInto(std::string& out, std::string_view key, std::span<const FormatArg> args,
+                 Escape escape = Escape::None) const;
+    // Same as trf(), rendered as segments that reference the catalog text and
+    // string arguments in place instead of copying them (see SegmentedOutput).
+    // Replaces the contents of `out`.
+    void trfSegments(SegmentedOutput& out, std::string_view key, std::span<const FormatArg> args,
+                     Escape escape = Escape::None) const;
+    // Same as trfSegments(), appending to `out` after the segments it holds
+    void trfSegmentsInto(SegmentedOutput& out, std::string_view key, std::span<const FormatArg> args,
+                         Escape escape = Escape::None) const;
+
+    // Lazy trf(): captures this instance, the key and the arguments without
+    // looking anything up; the message is rendered only when it reaches a
+    // sink (see Message)
+    template<typename... Args>
+    Message<sizeof...(Args)> msg(std::string_view key, Args&&... args) const {
+        static_assert(((!(std::is_same_v<std::remove_cvref_t<Args>, std::string>
+                          || std::is_same_v<std::remove_cvref_t<Args>, std::tm>)
+                        || std::is_lvalue_reference_v<Args>) && ...),
+                      "msg() keeps a view of string and std::tm arguments; pass an lvalue that outlives the message");
+        return Message<sizeof...(Args)>(*this, key, {FormatArg(args)...});
+    }
+
+    // Resolve many keys at once: the fallback chain is computed once per batch,
+    // duplicate keys are resolved once, and results land in `out`'s arena.
+    // Same resolution rules as tr(); bypasses the per-call translation cache.
+    void trBatch(std::span<const KeyRequest> requests, BatchOutput& out) const;
+
     bool keyExists(std::string_view key) const noexcept;
 
+    // Keys that have a translation in at least one loaded locale but none in
+    // `locale`, in catalog order. A single scan over the locale's value column.
+    std::vector<std::string> missingKeys(std::string_view locale) const;
+
+    // Calls `fn` with every key translated in some loaded locale that lies at
+    // or below the dotted `prefix` ("settings.privacy" matches
+    // settings.privacy and settings.privacy.*, not settings.privacy_policy),
+    // in key order. An empty prefix visits every key. Walks one contiguous
+    // subtree of the key trie instead of scanning the catalog.
+    void forEachKeyWithPrefix(std::string_view prefix, const std::function<void(std::string_view)>& fn) const;
+
+    // (key, translation) pairs for every key under `prefix`, resolved through
+    // the current locale chain like tr(key). Keys that do not resolve in the
+    // chain are omitted.
+    std::vector<std::pair<std::string, std::string>> trSubtree(std::string_view prefix) const;
+
+    // Renders every key under `prefix` (see trSubtree()) into a bundle for
+    // shipping to clients, and caches it per locale chain, prefix and format
+    // for the current catalog generation. Repeat calls return the cached
+    // bytes without copying. A prefix that matches no key renders an empty
+    // bundle and is not cached. The view stays valid until the catalog
+    // changes (load, merge or reset) or the cache is flushed after
+    // 256 distinct bundles.
+    std::string_view renderBundle(std::string_view prefix, BundleFormat format = BundleFormat::Json) const;
+
+    // Incremented by every change to catalog data (load, merge, reset).
+    uint64_t catalogGeneration() const noexcept;
+
+    // Precompute, for every key, the value tr() would pick from the current
+    // fallback chain (including the key.other fallback), so tr(), keyExists()
+    // and trBatch() read one table slot instead of walking the chain.
+    // Stays enabled until reset(): chains activated later by setLocale() or
+    // setFallbackLocale() are materialized on first use and kept per chain;
+    // loading catalog data drops all tables. trPlural() and trOrdinal() still
+    // walk the chain, since their candidate keys depend on each locale's
+    // plural rules.
+    // Returns materializedMemoryUsage().
+    size_t materializeFallbacks();
+
+    // Heap bytes held by materialized fallback tables.
+    size_t materializedMemoryUsage() const noexcept;
+
     void configure(const json& formats);
     const FormatConfig& getConfig() const noexcept;
 
     // Formatting
     std::string formatNumber(double number) const;
     std::string formatPrice(double amount) const;
+    // Price in the currency with ISO 4217 code `currency` for the active
+    // locale: its `_formats.currencies` entry, else the locale's own currency
+    // when the code matches its short_name, else that format with the code as
+    // symbol. Each (locale, currency) format is compiled once and kept until
+    // the locale or configuration changes, so switching currencies does not
+    // reconfigure anything.
+    std::string formatPrice(double amount, std::string_view currency) const;
     std::string formatDate(std::string_view pattern = "", const std::tm* date = nullptr) const;
+    // Abbreviated count with the locale's suffix table ("1.2K", "3,4 Mio.").
+    // Rounds half to even; a value that rounds up to the next magnitude moves
+    // there ("1M", not "1000K").
+    std::string formatCompact(int64_t value) const;
+    // `ratio` as a percentage (0.256 -> "26%"), rounded half to even
+    std::string formatPercent(double ratio) const;
+    // Relative time for `delta` = event time - now: "3 minutes ago" for
+    // -180 s, "in 2 days" for +2 days, and `now` for 0. Uses the largest unit
+    // that fits (weeks below a month, months of 30.44 days), counting whole
+    // units down, and the active locale's `_formats.relative` template for
+    // the count's plural category. Templates are compiled once per locale.
+    std::string formatRelative(std::chrono::seconds delta) const;
+    // formatRelative() for many deltas into one arena. Consecutive deltas in
+    // the same unit reuse its bounds, and those that also have the same count
+    // share one rendered slice, so time-sorted feeds render few strings.
+    void formatRelativeBatch(std::span<const std::chrono::seconds> deltas, BatchOutput& out) const;
+    // Nonzero units of `duration`, largest first ("2 h 15 min"), with the
+    // active locale's `_formats.duration` templates and plural rules; zero is
+    // "0 s". Truncates below the last unit shown.
+    std::string formatDuration(std::chrono::seconds duration) const;
+    // `items` joined with the active locale's `_formats.list` patterns
+    // ("A, B, and C")
+    std::string formatList(std::span<const std::string_view> items) const;
+    // Same as formatDuration() / formatList(), appending to `out` after
+    // reserving the exact result size
+    void formatDurationInto(std::string& out, std::chrono::seconds duration) const;
+    void formatListInto(std::string& out, std::span<const std::string_view> items) const;
+    // `n` with the active locale's `_formats.ordinal` template for its
+    // ordinal category ("1st", "22nd", "113th"). Templates are compiled once
+    // per locale; the Into variant appends to `out`.
+    std::string formatOrdinal(int64_t n) const;
+    void formatOrdinalInto(std::string& out, int64_t n) const;
 
     void reset();
 
     size_t formatCacheSize() const noexcept;
     size_t translationCacheSize() const noexcept;
+    size_t bundleCacheSize() const noexcept;
 
 private:
+    static constexpr uint32_t kNoEntry = static_cast<uint32_t>(-1);
+
+    // Positional parameters for {N} / {} interpolation, viewed in place: the
+    // caller's std::string or std::string_view span, optionally preceded by a
+    // virtual slot 0 (trPlural()'s count) so nothing is copied to prepend it.
+    class ParamList {
+    public:
+        ParamList() = default;
+        ParamList(std::span<const std::string> strings) : strings_(strings.data()), count_(strings.size()) {}
+        ParamList(std::span<const std::string_view> views) : views_(views.data()), count_(views.size()) {}
+
+        ParamList withLeading(std::string_view first) const {
+            ParamList list = *this;
+            list.leading_ = first;
+            list.hasLeading_ = true;
+            return list;
+        }
+
+        size_t size() const noexcept { return count_ + (hasLeading_ ? 1 : 0); }
+        bool empty() const noexcept { return size() == 0; }
+
+        std::string_view operator[](size_t index) const noexcept {
+            if (hasLeading_) {
+                if (index == 0) {
+                    return leading_;
+                }
+                --index;
+            }
+            return strings_ ? std::string_view(strings_[index]) : views_[index];
+        }
+
+    private:
+        const std::string* strings_ = nullptr;
+        const std::string_view* views_ = nullptr;
+        size_t count_ = 0;
+        std::string_view leading_;
+        bool hasLeading_ = false;
+    };
+
+    // Catalog layout: every key is interned once in `keyIndex_` and its
+    // position there is the key id. Each locale owns a column indexed by key
+    // id holding an offset into its value pool, or kNoEntry when the locale
+    // has no translation. Resolving a key through the fallback chain is one
+    // hash probe followed by one array read per locale.
+    struct KeyInfo {
+        uint32_t otherId = kNoEntry; // id of "<key>.other", tried by tr() after the key itself
+        bool hasCountForms = false;  // some "<key>.<integer>" exists, so trPlural() caches per count
+    };
+
+    // One inlined message reference inside an expanded value: the bytes
+    // [offset, offset + length) came from `refId`, written in the source as
+    // "@:key" or, when `call` is set, "$t(key)".
+    struct MessageSplice {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+        uint32_t refId = kNoEntry;
+        bool call = false;
+    };
+
+    struct LocaleColumn {
+        std::vector<uint32_t> slots;     // key id -> index into values, or kNoEntry
+        std::vector<std::string> values;
+        // Values that reference other messages ("@:key" or "$t(key)"), by key
+        // id. `values` holds only the expanded text; its source is recovered
+        // from these splices when resolveMessageReferences() re-expands it.
+        std::unordered_map<uint32_t, std::vector<MessageSplice>> links;
+        // VariantRange::id -> whether the base is a leaf object in this
+        // locale; rebuilt with the variant tables.
+        std::vector<bool> variants;
+
+        const std::string* value(uint32_t id) const noexcept {
+            return id < slots.size() && slots[id] != kNoEntry ? &values[slots[id]] : nullptr;
+        }
+    };
+
+    // What a load changes before its references are resolved, kept so a load
+    // that adds a reference cycle can be undone. Entries are std::nullopt for
+    // a locale that had no column or config yet.
+    struct CatalogSnapshot {
+        FormatConfig defaultConfig;
+        std::vector<std::pair<std::string, std::optional<FormatConfig>>> formatConfigs;
+        std::vector<std::pair<std::string, std::optional<LocaleColumn>>> columns;
+    };
+
+    // Key trie over dotted segments, stored in depth-first order so every
+    // subtree is the contiguous node range [node, subtreeEnd). Children of a
+    // node follow it directly and are chained by their subtreeEnd. Each
+    // segment is stored once, however many keys share it.
+    struct TrieNode {
+        uint32_t segmentOffset = 0; // into trieSegments_
+        uint32_t segmentLength = 0;
+        uint32_t keyId = kNoEntry;  // translated key ending at this node
+        uint32_t subtreeEnd = 0;
+    };
+
+    // Forms of a variant leaf ("pronoun" -> male, female, other): the
+    // children of a trie node whose children are all leaves, i.e. a leaf
+    // object in the source JSON (see flattenJson()). Found at load time so
+    // translate() matches a param value against a small table instead of
+    // probing "<key>.<value>" per param and locale. Whether a node is a leaf
+    // object is decided per locale, since locales may shape a key differently.
+    struct VariantForm {
+        uint32_t segmentOffset = 0; // into trieSegments_
+        uint32_t segmentLength = 0;
+        uint32_t keyId = kNoEntry;
+    };
+
+    struct VariantRange {
+        uint32_t begin = 0; // into variantForms_
+        uint32_t end = 0;
+        uint32_t id = 0;    // into LocaleColumn::variants
+    };
+
+    struct ChainLink {
+        std::string locale;
+        const LocaleColumn* column;
+        int pluralRule;  // see pluralRuleFor()
+        int ordinalRule; // see ordinalRuleFor()
+    };
+
+    // trPlural() / trOrdinal() template for one (key, chain categories)
+    // combination.
+    // `text` is nullptr for a miss; `perCount` marks keys with exact-count
+    // forms, whose results are cached per count in translationCache_.
+    // `lastResult` memoizes the most recent rendering, for `lastCount` and the
+    // params each prefixed with '\0' in `lastParams`, so a hot fixed-count
+    // call copies instead of re-rendering while entries stay per category.
+    struct PluralTemplate {
+        const std::string* text = nullptr;
+        bool perCount = false;
+        bool hasLast = false;
+        int lastCount = 0;
+        std::string lastParams;
+        std::string lastResult;
+    };
+
+    // translate() entry for one key and selector set (every string param,
+    // plus the numeric count). `refs` lists the non-string params the
+    // template interpolates; when it is empty `text` is the final rendered
+    // result, otherwise it is the template and results are cached per
+    // value of `refs` in translateCache_.
+    struct TranslateTemplate {
+        std::string text;
+        std::vector<std::string> refs;
+    };
+
+    // trf() placeholder compiled from a template: `{index[,width][:type[:pattern]]}`
+    enum class PlaceholderType : uint8_t { Plain, Number, Price, Date, Compact, Percent, Ordinal };
+
+    struct TemplatePart {
+        uint32_t offset = 0;        // slice of the template: the literal, or
+        uint32_t length = 0;        // the placeholder kept if its arg is missing
+        uint32_t patternOffset = 0; // Date pattern, also a slice of the template
+        uint32_t patternLength = 0;
+        int32_t argIndex = -1;      // -1 for a literal
+        int32_t width = 0;          // > 0 right-aligns, < 0 left-aligns
+        PlaceholderType type = PlaceholderType::Plain;
+    };
+
+    // A CurrencyConfig compiled for one ISO 4217 code: each sign's format is
+    // split at its %q placeholders with %c and %p already substituted, so
+    // formatting only appends the literals around the grouped number.
+    struct CurrencyFormatter {
+        std::vector<std::string> positive;
+        std::vector<std::string> negative;
+        std::string decimalSymbol;
+        std::string thousandSeparator;
+        std::string positiveSymbol;
+        std::string negativeSymbol;
+        int fractDigits = 2;
+    };
+    static constexpr size_t kCurrencyFormatterLimit = 256;
+
+    // A template with at most one count placeholder, split around it
+    struct CountPiece {
+        std::string prefix;
+        std::string suffix;
+        bool hasCount = false;
+    };
+    // One CountPiece per plural category, "other" filling missing ones
+    using CountForms = std::array<CountPiece, 6>;
+
+    // RelativeTimeConfig compiled for the active locale, indexed
+    // [future][unit]
+    static constexpr size_t kRelativeUnits = 7;
+    struct RelativeFormatter {
+        std::string now;
+        std::array<std::array<CountForms, kRelativeUnits>, 2> forms;
+        int pluralRule = 1;
+    };
+
+    // ListConfig pattern split around {0} and {1}
+    struct ListPattern {
+        std::string before;
+        std::string between;
+        std::string after;
+    };
+    struct ListFormatter {
+        ListPattern pair;
+        ListPattern start;
+        ListPattern middle;
+        ListPattern end;
+    };
+
+    // DurationConfig compiled for the active locale, units largest first
+    static constexpr size_t kDurationUnits = 4;
+    struct DurationFormatter {
+        std::array<CountForms, kDurationUnits> forms;
+        std::string separator;
+        size_t maxUnits = kDurationUnits;
+        int pluralRule = 1;
+    };
+
+    // OrdinalConfig compiled for the active locale
+    struct OrdinalFormatter {
+        CountForms forms;
+        int ordinalRule = 1;
+    };
+
+    // trf() template for one key and escape mode under the current chain;
+    // `text` is nullptr when the key does not resolve. Escaped templates own
+    // their text: literals escaped for the mode, patterns and codes raw. It is
+    // held by pointer so trfSegments() views survive cache growth.
+    struct CompiledTemplate {
+        const std::string* text = nullptr;
+        std::unique_ptr<std::string> escapedText;
+        std::vector<TemplatePart> parts;
+
+        std::string_view source() const noexcept {
+            return escapedText ? std::string_view(*escapedText) : std::string_view(*text);
+        }
+    };
+
+    // translate() caches are cleared wholesale once they hold this many
+    // entries, since named params may carry unbounded free-form values.
+    static constexpr size_t kTranslateCacheLimit = 4096;
+
+    // renderBundle() cache bound; bundles can span the whole catalog, so the
+    // limit is far lower than for single translations.
+    static constexpr size_t kBundleCacheLimit = 256;
+
+    // Negative tr()/trPlural() entries are keyed by caller-supplied strings,
+    // so translationCache_ and pluralCache_ are flushed once this many misses
+    // have been stored.
+    static constexpr size_t kNegativeCacheLimit = 1024;
+
+    static constexpr std::array<std::string_view, 6> kPluralCategories = {
+        "zero", "one", "two", "few", "many", "other"
+    };
+
     std::vector<std::string> locales;
     std::string fallbackLocale;
-    std::unordered_map<std::string, std::unordered_map<std::string, std::string, StringHash, StringEqual>, StringHash, StringEqual> localesData;
+    FlatStringMap<KeyInfo> keyIndex_;
+    KeyFilter keyFilter_;            // rebuilt after every catalog load
+    std::vector<TrieNode> keyTrie_;  // node 0 is the root; rebuilt with keyFilter_
+    std::string trieSegments_;
+    FlatStringMap<VariantRange> variantIndex_; // base key -> its forms; rebuilt with keyTrie_
+    std::vector<VariantForm> variantForms_;
+    uint64_t catalogGeneration_ = 0;
+    std::unordered_map<std::string, LocaleColumn, StringHash, StringEqual> localesData;
+    // Loaded locales of getFallbacks(locales), rebuilt by every mutator that
+    // changes the locale list, the fallback locale or the set of columns.
+    std::vector<ChainLink> chain_;
+    // materializeFallbacks() tables: key id -> resolved value (or nullptr),
+    // keyed by the chain's locale names joined with '\0'.
+    bool materializeFallbacks_ = false;
+    std::unordered_map<std::string, std::vector<const std::string*>, StringHash, StringEqual> materializedChains_;
+    const std::vector<const std::string*>* activeMaterialized_ = nullptr;
     std::unordered_map<std::string, FormatConfig, StringHash, StringEqual> formatConfigs;
     FormatConfig defaultConfig;
     FormatConfig baselineConfig_;
     // NOTE: the following mutable members are written from const methods —
     // see class-level thread-safety \warning above. Do not assume const methods
     // are safe to call on a shared instance from multiple threads.
-    mutable std::unordered_map<std::string, std::string, StringHash, StringEqual> formatCache_;
-    mutable std::unordered_map<std::string, std::string, StringHash, StringEqual> translationCache_;
+    mutable FlatStringMap<std::string> formatCache_;
+    mutable FlatStringMap<CurrencyFormatter> currencyFormatters_; // ISO code -> formatter for the active locale
+    mutable std::optional<RelativeFormatter> relativeFormatter_;   // compiled on first use per locale
+    mutable std::optional<ListFormatter> listFormatter_;
+    mutable std::optional<DurationFormatter> durationFormatter_;
+    mutable std::optional<OrdinalFormatter> ordinalFormatter_;
+    mutable FlatStringMap<std::string> translationCache_;
+    mutable size_t negativeCacheEntries_ = 0; // misses stored in translationCache_ / pluralCache_
+    mutable FlatStringMap<PluralTemplate> pluralCache_;
+    mutable FlatStringMap<CompiledTemplate> templateCache_;
+    FlatStringMap<TranslateTemplate> translateTemplates_;
+    FlatStringMap<std::string> translateCache_;
     mutable std::string interpolateBuf_;
     mutable std::string interpolateBuf2_;
-    mutable std::vector<std::string> extendedParamsBuf_;
+    mutable std::string cacheKeyBuf_;
+    // renderBundle() output keyed by format, chain locales and prefix; node
+    // based so returned views survive later insertions. Cleared when the
+    // catalog generation changes or kBundleCacheLimit is reached.
+    mutable std::unordered_map<std::string, std::string, StringHash, StringEqual> bundleCache_;
 
     // Helper functions
     void clearFormatCache();
     void clearTranslationCache();
     const std::string* getTranslationData(std::string_view key, std::string_view locale) const;
+    size_t findKeyId(std::string_view key) const noexcept;
+    size_t findKeyId(std::string_view key, size_t hash) const noexcept;
+    const std::string* resolveInChain(size_t keyId) const noexcept;
+    const std::string* walkChain(size_t keyId) const noexcept;
+    void activateMaterializedChain();
+    uint32_t internKey(std::string_view key);
+    void storeLocaleData(const std::string& locale, FlatStringMap<std::string>& flat, bool replace);
+    CatalogSnapshot snapshotFormats(const std::vector<std::string>& loaded) const;
+    // Copies the columns of the `loaded` locales and of their descendants
+    void snapshotColumns(CatalogSnapshot& snapshot, const std::vector<std::string>& loaded) const;
+    void restoreCatalog(CatalogSnapshot& snapshot);
+    void rebuildKeyIndexes();
+    // Inlines message references into the values of the `loaded` locales
+    // and of their descendants (en-US for en), whose expansions read them.
+    // Returns a description of the first reference cycle found in a `loaded`
+    // locale (left unexpanded), or an empty string.
+    std::string resolveMessageReferences(const std::vector<std::string>& loaded);
+    size_t findTrieNode(std::string_view prefix) const noexcept;
+    uint32_t findVariant(const VariantRange& range, std::string_view value) const noexcept;
+    void rebuildChain();
     
     std::string interpolate(std::string_view text, const json& params) const;
 
-    std::string interpolateArray(std::string_view text, std::span<const std::string> params) const;
+    std::string interpolateArray(std::string_view text, const ParamList& params) const;
+    void interpolateArrayInto(std::string& out, std::string_view text, const ParamList& params) const;
 
-    std::string getPluralForm(std::string_view locale, int count) const;
+    std::string trImpl(std::string_view key, const ParamList& params) const;
+    void noteCacheMiss() const;
+    std::string trPluralImpl(std::string_view key, int count, const ParamList& params, bool ordinal) const;
+    const CompiledTemplate& compiledTemplate(std::string_view key, Escape escape) const;
+    static CompiledTemplate compileTemplate(const std::string& text, Escape escape);
+    void renderTemplate(std::string& out, const CompiledTemplate& compiled, std::span<const FormatArg> args,
+                        Escape escape) const;
+    void appendArg(std::string& out, const FormatArg& arg, PlaceholderType type, std::string_view pattern) const;
 
-    void flattenJson(const std::string& prefix, const json& node, std::unordered_map<std::string, std::string, StringHash, StringEqual>& flatMap);
-    void flattenJson(const std::string& prefix, json&& node, std::unordered_map<std::string, std::string, StringHash, StringEqual>& flatMap);
+    std::string_view getPluralForm(std::string_view locale, int count) const;
+    int pluralRuleFor(std::string_view locale) const;
+    // Index into kPluralCategories for `count` under `rule`
+    static size_t pluralCategory(int rule, int count) noexcept;
+    int ordinalRuleFor(std::string_view locale) const;
+    // Index into kPluralCategories for the ordinal `n` under `rule`
+    static size_t ordinalCategory(int rule, int n) noexcept;
+    // The category `count` selects in `link`'s locale
+    static size_t linkCategory(const ChainLink& link, int count, bool ordinal) noexcept;
+    PluralTemplate resolvePluralTemplate(std::string_view key, int count, bool ordinal) const;
+    const std::string* resolveTranslateTemplate(std::string_view key, const json& params) const;
+
+    void flattenJson(const std::string& prefix, const json& node, FlatStringMap<std::string>& flatMap);
+    void flattenJson(const std::string& prefix, json&& node, FlatStringMap<std::string>& flatMap);
 
     std::vector<std::string> getLocaleAncestry(std::string_view locale) const;
     
@@ -254,8 +1354,26 @@ private:
     std::string formatNumberWithConfig(double number, const NumberConfig& config) const;
     std::string formatPriceWithConfig(double amount, const CurrencyConfig& config) const;
     std::string formatDateWithConfig(std::string_view pattern, const std::tm* date, const DateTimeConfig& config) const;
+    void appendNumber(std::string& out, double number, const NumberConfig& config) const;
+    void appendCompact(std::string& out, int64_t value) const;
+    void appendPercent(std::string& out, double ratio) const;
+    void appendOrdinal(std::string& out, int64_t n) const;
+    const RelativeFormatter& relativeFormatter() const;
+    const ListFormatter& listFormatter() const;
+    const DurationFormatter& durationFormatter() const;
+    const OrdinalFormatter& ordinalFormatter() const;
+    static void splitTemplate(const std::string& text, std::vector<std::string>& literals, std::vector<int32_t>& args);
+    static bool compileListPattern(const std::string& text, ListPattern& pattern);
+    static void compileCountForms(const std::map<std::string, std::string, std::less<>>& templates, CountForms& forms);
+    static void appendRelative(std::string& out, const RelativeFormatter& formatter, bool future, size_t unit,
+                               uint64_t count);
+    void appendPrice(std::string& out, double amount, const CurrencyConfig& config) const;
+
+    const CurrencyFormatter& currencyFormatter(std::string_view currency) const;
+    static CurrencyFormatter compileCurrency(const CurrencyConfig& config);
+    static void appendCurrency(std::string& out, double amount, const CurrencyFormatter& formatter);
+    void appendDate(std::string& out, std::string_view pattern, const std::tm* date, const DateTimeConfig& config) const;
     
-    std::string separateThousand(std::string_view amount, std::string_view separator) const;
 
     template<typename T>
     std::string toString(const T& value) const {
@@ -286,7 +1404,130 @@ private:
     }
 };
 
+/// A translation that has not been rendered yet, returned by `I18N::msg()`.
+/// Creating, copying or dropping one does no lookup and no allocation; the
+/// trf() template is resolved and rendered only when the message is streamed,
+/// appended to a buffer or converted to a string, using the instance's locale
+/// at that moment. Like FormatArg, it holds views: the instance, the key and
+/// string or `std::tm` arguments must outlive the message.
+template<size_t N>
+class Message {
+public:
+    Message(const I18N& i18n, std::string_view key, std::array<FormatArg, N> args) noexcept
+        : i18n_(&i18n), key_(key), args_(args) {}
+
+    std::string_view key() const noexcept { return key_; }
+    std::span<const FormatArg> args() const noexcept { return args_; }
+
+    void appendTo(std::string& out, Escape escape = Escape::None) const {
+        i18n_->trfInto(out, key_, args_, escape);
+    }
+
+    // Appends after the segments `out` already holds, so several messages
+    // can be gathered into one write
+    void appendTo(SegmentedOutput& out, Escape escape = Escape::None) const {
+        i18n_->trfSegmentsInto(out, key_, args_, escape);
+    }
+
+    // Copies the rendered segments to an output iterator, reusing a
+    // per-thread output
+    template<typename OutputIt>
+    OutputIt formatTo(OutputIt out) const {
+        thread_local SegmentedOutput segments;
+        segments.clear();
+        appendTo(segments);
+        for (size_t i = 0; i < segments.size(); ++i) {
+            const std::string_view segment = segments[i];
+            out = std::copy(segment.begin(), segment.end(), out);
+        }
+        return out;
+    }
+
+    std::string str(Escape escape = Escape::None) const {
+        return i18n_->trf(key_, args_, escape);
+    }
+
+    operator std::string() const {
+        return str();
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const Message& message) {
+        message.formatTo(std::ostreambuf_iterator<char>(os));
+        return os;
+    }
+
+private:
+    const I18N* i18n_;
+    std::string_view key_;
+    std::array<FormatArg, N> args_;
+};
+
 } // namespace i18n
 
+// `std::format("{}", i18n.msg(...))` renders the message straight into the
+// format context's output. A spec (`{:>20}`) is applied through the string
+// formatter, which needs the text in one piece first.
+#ifdef I18N_HAS_STD_FORMATTER
+template<size_t N>
+struct std::formatter<i18n::Message<N>, char> : std::formatter<std::string_view, char> {
+    bool plain = true;
+
+    constexpr auto parse(std::format_parse_context& ctx) {
+        plain = ctx.begin() == ctx.end() || *ctx.begin() == '}';
+        return std::formatter<std::string_view, char>::parse(ctx);
+    }
+
+    template<typename FormatContext>
+    auto format(const i18n::Message<N>& message, FormatContext& ctx) const {
+        if (plain) {
+            // Segment by segment, so each is copied in bulk
+            thread_local i18n::SegmentedOutput segments;
+            segments.clear();
+            message.appendTo(segments);
+            for (size_t i = 0; i < segments.size(); ++i) {
+                const std::string_view segment = segments[i];
+                ctx.advance_to(std::formatter<std::string_view, char>::format(std::string_view(segment.data(), segment.size()), ctx));
+            }
+            return ctx.out();
+        }
+        thread_local std::string text;
+        text.clear();
+        message.appendTo(text);
+        return std::formatter<std::string_view, char>::format(text, ctx);
+    }
+};
+#endif
+
+#ifdef I18N_HAS_FMT_FORMATTER
+template<size_t N>
+struct fmt::formatter<i18n::Message<N>, char> : fmt::formatter<fmt::string_view, char> {
+    bool plain = true;
+
+    constexpr auto parse(fmt::format_parse_context& ctx) {
+        plain = ctx.begin() == ctx.end() || *ctx.begin() == '}';
+        return fmt::formatter<fmt::string_view, char>::parse(ctx);
+    }
+
+    template<typename FormatContext>
+    auto format(const i18n::Message<N>& message, FormatContext& ctx) const {
+        if (plain) {
+            // Segment by segment, so each is copied in bulk
+            thread_local i18n::SegmentedOutput segments;
+            segments.clear();
+            message.appendTo(segments);
+            for (size_t i = 0; i < segments.size(); ++i) {
+                const std::string_view segment = segments[i];
+                ctx.advance_to(fmt::formatter<fmt::string_view, char>::format(fmt::string_view(segment.data(), segment.size()), ctx));
+            }
+            return ctx.out();
+        }
+        thread_local std::string text;
+        text.clear();
+        message.appendTo(text);
+        return fmt::formatter<fmt::string_view, char>::format(fmt::string_view(text.data(), text.size()), ctx);
+    }
+};
+#endif
+
 #endif // I18NCPP_H
 
@@ -11,13 +11,14 @@
 #include <array>
 #include <charconv>
 #include <filesystem>
+#include <iterator>
 
 #if __has_include(<format>) && defined(__cpp_lib_format) && (__cpp_lib_format >= 201907L)
     #include <format>
-    namespace i18n_fmt { using std::format; }
+    namespace i18n_fmt { using std::format; using std::format_to; }
 #else
     #include <fmt/format.h>
-    namespace i18n_fmt { using fmt::format; }
+    namespace i18n_fmt { using fmt::format; using fmt::format_to; }
 #endif
 
 #if defined(_WIN32)
@@ -28,24 +29,235 @@
 
 namespace i18n {
 
+// Per-byte "needs escaping" tables for each Escape mode
+static constexpr std::array<std::array<bool, 256>, 4> kEscapeTables = [] {
+    std::array<std::array<bool, 256>, 4> tables{};
+    for (int c = 0; c < 256; ++c) {
+        tables[static_cast<size_t>(Escape::Html)][c] = c == '&' || c == '<' || c == '>' || c == '"' || c == '\'';
+        tables[static_cast<size_t>(Escape::Json)][c] = c < 0x20 || c == '"' || c == '\\';
+        const bool unreserved = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')
+                             || c == '-' || c == '_' || c == '.' || c == '~';
+        tables[static_cast<size_t>(Escape::Url)][c] = !unreserved;
+    }
+    return tables;
+}();
+
+// Index of the first byte of `text` at or after `pos` that `mode` must
+// escape, or text.size(). HTML and JSON text is mostly safe, so those modes
+// test 16 bytes per step with SSE2; URL components are scanned by table.
+static size_t findEscapable(std::string_view text, size_t pos, Escape mode) {
+    const auto& table = kEscapeTables[static_cast<size_t>(mode)];
+#ifdef I18N_HAS_SSE2
+    if (mode == Escape::Html || mode == Escape::Json) {
+        for (; pos + 16 <= text.size(); pos += 16) {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + pos));
+            __m128i hits;
+            if (mode == Escape::Html) {
+                hits = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('&')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('<'))),
+                    _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('>')),
+                                 _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\'')))));
+            } else {
+                // Unsigned c < 0x20 as a signed compare on c ^ 0x80
+                const __m128i control = _mm_cmplt_epi8(_mm_xor_si128(bytes, _mm_set1_epi8(static_cast<char>(0x80))),
+                                                       _mm_set1_epi8(static_cast<char>(0x20 ^ 0x80)));
+                hits = _mm_or_si128(control,
+                    _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\'))));
+            }
+            const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+            if (mask != 0) {
+                return pos + static_cast<size_t>(std::countr_zero(mask));
+            }
+        }
+    }
+#endif
+    while (pos < text.size() && !table[static_cast<unsigned char>(text[pos])]) {
+        ++pos;
+    }
+    return pos;
+}
+
+// Appends `text` escaped for `mode`. JSON output is the string's contents,
+// without the surrounding quotes.
+static void appendEscaped(std::string& out, std::string_view text, Escape mode) {
+    static constexpr char kHex[] = "0123456789abcdef";
+    static constexpr char kUpperHex[] = "0123456789ABCDEF";
+    if (mode == Escape::None) {
+        out.append(text);
+        return;
+    }
+    size_t runStart = 0;
+    for (size_t i = findEscapable(text, 0, mode); i < text.size(); i = findEscapable(text, i + 1, mode)) {
+        const unsigned char c = static_cast<unsigned char>(text[i]);
+        out.append(text, runStart, i - runStart);
+        runStart = i + 1;
+        if (mode == Escape::Url) {
+            out.push_back('%');
+            out.push_back(kUpperHex[c >> 4]);
+            out.push_back(kUpperHex[c & 0xF]);
+        } else if (mode == Escape::Html) {
+            switch (c) {
+                case '&': out.append("&amp;"); break;
+                case '<': out.append("&lt;"); break;
+                case '>': out.append("&gt;"); break;
+                case '"': out.append("&quot;"); break;
+                default: out.append("&#39;"); break;
+            }
+        } else {
+            switch (c) {
+                case '"': out.append("\\\""); break;
+                case '\\': out.append("\\\\"); break;
+                case '\n': out.append("\\n"); break;
+                case '\r': out.append("\\r"); break;
+                case '\t': out.append("\\t"); break;
+                default:
+                    out.append("\\u00");
+                    out.push_back(kHex[c >> 4]);
+                    out.push_back(kHex[c & 0xF]);
+            }
+        }
+    }
+    out.append(text, runStart, std::string_view::npos);
+}
+
+static void appendJsonString(std::string& out, std::string_view text) {
+    out.push_back('"');
+    appendEscaped(out, text, Escape::Json);
+    out.push_back('"');
+}
+
+static void appendVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+// Appends a type-tagged encoding of a scalar param to a translate() cache
+// key: integers, unsigned integers and doubles that print differently never
+// compare equal. Returns false for objects, arrays and binary values, which
+// are not cached.
+static bool appendParamKey(std::string& out, const json& value) {
+    switch (value.type()) {
+        case json::value_t::null:
+            out.push_back('n');
+            return true;
+        case json::value_t::boolean:
+            out.push_back(value.get<bool>() ? 't' : 'f');
+            return true;
+        case json::value_t::string: {
+            const auto& text = value.get_ref<const json::string_t&>();
+            out.push_back('s');
+            appendVarint(out, text.size());
+            out.append(text);
+            return true;
+        }
+        case json::value_t::number_integer: {
+            const auto number = value.get<json::number_integer_t>();
+            out.push_back('i');
+            out.append(reinterpret_cast<const char*>(&number), sizeof(number));
+            return true;
+        }
+        case json::value_t::number_unsigned: {
+            const auto number = value.get<json::number_unsigned_t>();
+            out.push_back('u');
+            out.append(reinterpret_cast<const char*>(&number), sizeof(number));
+            return true;
+        }
+        case json::value_t::number_float: {
+            const auto number = value.get<json::number_float_t>();
+            out.push_back('d');
+            out.append(reinterpret_cast<const char*>(&number), sizeof(number));
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+// A message reference inside a catalog value: "@:key.path" or "$t(key.path)".
+// [begin, end) is the whole reference in the text.
+struct MessageReference {
+    size_t begin = 0;
+    size_t end = 0;
+    std::string_view key;
+};
+
+// Finds the first message reference at or after `pos`. An "@:" key runs over
+// [A-Za-z0-9_.-] and drops a trailing '.', so "Try @:brand." ends at "brand".
+static bool nextMessageReference(std::string_view text, size_t pos, MessageReference& ref) {
+    while ((pos = text.find_first_of("@$", pos)) != std::string_view::npos) {
+        if (text.substr(pos, 2) == "@:") {
+            size_t end = pos + 2;
+            while (end < text.size() && (std::isalnum(static_cast<unsigned char>(text[end]))
+                                         || text[end] == '_' || text[end] == '.' || text[end] == '-')) {
+                ++end;
+            }
+            while (end > pos + 2 && text[end - 1] == '.') {
+                --end;
+            }
+            if (end > pos + 2) {
+                ref = MessageReference{pos, end, text.substr(pos + 2, end - pos - 2)};
+                return true;
+            }
+        } else if (text.substr(pos, 3) == "$t(") {
+            const size_t close = text.find(')', pos + 3);
+            if (close != std::string_view::npos && close > pos + 3) {
+                ref = MessageReference{pos, close + 1, text.substr(pos + 3, close - pos - 3)};
+                return true;
+            }
+        }
+        ++pos;
+    }
+    return false;
+}
+
+// Whether any value references another message; only such a load can add a
+// reference cycle
+static bool hasMessageReferences(const FlatStringMap<std::string>& flat) {
+    MessageReference ref;
+    for (const auto& entry : flat) {
+        if (nextMessageReference(entry.value, 0, ref)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 I18N::I18N() {
     reset();
 }
 
 void I18N::clearFormatCache() {
     formatCache_.clear();
+    currencyFormatters_.clear();
+    relativeFormatter_.reset();
+    listFormatter_.reset();
+    durationFormatter_.reset();
+    ordinalFormatter_.reset();
 }
 
 void I18N::clearTranslationCache() {
     translationCache_.clear();
+    negativeCacheEntries_ = 0;
+    pluralCache_.clear();
+    translateTemplates_.clear();
+    translateCache_.clear();
+    templateCache_.clear();
 }
 
 size_t I18N::formatCacheSize() const noexcept {
     return formatCache_.size();
 }
 
+size_t I18N::bundleCacheSize() const noexcept {
+    return bundleCache_.size();
+}
+
 size_t I18N::translationCacheSize() const noexcept {
-    return translationCache_.size();
+    return translationCache_.size() + pluralCache_.size()
+        + translateTemplates_.size() + translateCache_.size() + templateCache_.size();
 }
 
 void I18N::loadLocale(std::string_view locale, std::string_view filePath) {
@@ -57,6 +269,8 @@ void I18N::loadLocale(std::string_view locale, std::string_view filePath) {
     try {
         json data = json::parse(fileStream);
         std::string localeStr(locale);
+        const std::vector<std::string> loaded{localeStr};
+        CatalogSnapshot snapshot = snapshotFormats(loaded);
 
         // Extract formatting configuration if present
         if (data.contains("_formats") && data["_formats"].is_object()) {
@@ -64,10 +278,23 @@ void I18N::loadLocale(std::string_view locale, std::string_view filePath) {
             formatConfigs[localeStr] = defaultConfig;
         }
 
-        localesData[localeStr].clear();
-        flattenJson("", std::move(data), localesData[localeStr]);
+        FlatStringMap<std::string> flat;
+        flattenJson("", std::move(data), flat);
+        if (hasMessageReferences(flat)) {
+            snapshotColumns(snapshot, loaded);
+        }
+        storeLocaleData(localeStr, flat, true);
+        const std::string cycle = resolveMessageReferences(loaded);
+        if (!cycle.empty()) {
+            restoreCatalog(snapshot);
+        }
+        rebuildKeyIndexes();
+        rebuildChain();
         clearFormatCache();
         clearTranslationCache();
+        if (!cycle.empty()) {
+            throw I18NError(cycle);
+        }
     } catch (const json::exception& e) {
         throw I18NError("Failed to parse JSON from file: " + std::string(filePath) + " - " + e.what());
     }
@@ -102,6 +329,8 @@ void I18N::mergeLocale(std::string_view locale, std::string_view filePath) {
     try {
         json data = json::parse(fileStream);
         std::string localeStr(locale);
+        const std::vector<std::string> loaded{localeStr};
+        CatalogSnapshot snapshot = snapshotFormats(loaded);
 
         if (data.contains("_formats") && data["_formats"].is_object()) {
             configure(data["_formats"]);
@@ -109,13 +338,23 @@ void I18N::mergeLocale(std::string_view locale, std::string_view filePath) {
         }
 
         // Flatten into temporary map and merge into existing
-        std::unordered_map<std::string, std::string, StringHash, StringEqual> tempFlat;
+        FlatStringMap<std::string> tempFlat;
         flattenJson("", std::move(data), tempFlat);
-        for (auto& [k, v] : tempFlat) {
-            localesData[localeStr][std::move(k)] = std::move(v);
+        if (hasMessageReferences(tempFlat)) {
+            snapshotColumns(snapshot, loaded);
         }
+        storeLocaleData(localeStr, tempFlat, false);
+        const std::string cycle = resolveMessageReferences(loaded);
+        if (!cycle.empty()) {
+            restoreCatalog(snapshot);
+        }
+        rebuildKeyIndexes();
+        rebuildChain();
         clearFormatCache();
         clearTranslationCache();
+        if (!cycle.empty()) {
+            throw I18NError(cycle);
+        }
     } catch (const json::exception& e) {
         throw I18NError("Failed to parse JSON from file: " + std::string(filePath) + " - " + e.what());
     }
@@ -142,28 +381,52 @@ void I18N::mergeLocaleFromFile(std::string_view filePath) {
 }
 
 void I18N::load(const json& data) {
+    // Top-level keys are locale identifiers
+    std::vector<std::string> loaded;
+    for (auto it = data.begin(); it != data.end(); ++it) {
+        if (it.value().is_object()) {
+            loaded.push_back(it.key());
+        }
+    }
+    CatalogSnapshot snapshot = snapshotFormats(loaded);
+
+    // Every locale is flattened before any is stored, so the columns are
+    // copied only when some value has a reference
+    std::vector<FlatStringMap<std::string>> flats;
+    flats.reserve(loaded.size());
     try {
-        // Top-level keys are locale identifiers
         for (auto it = data.begin(); it != data.end(); ++it) {
             if (!it.value().is_object()) continue;
 
-            std::string localeStr = it.key();
-
             if (it.value().contains("_formats") && it.value()["_formats"].is_object()) {
                 configure(it.value()["_formats"]);
-                formatConfigs[localeStr] = defaultConfig;
+                formatConfigs[it.key()] = defaultConfig;
             }
 
-            localesData[localeStr].clear();
-            flattenJson("", it.value(), localesData[localeStr]);
+            flattenJson("", it.value(), flats.emplace_back());
         }
     } catch (const json::exception& e) {
         clearFormatCache();
-        clearTranslationCache();
         throw I18NError(std::string("load: ") + e.what());
     }
+
+    if (std::any_of(flats.begin(), flats.end(), hasMessageReferences)) {
+        snapshotColumns(snapshot, loaded);
+    }
+    for (size_t i = 0; i < loaded.size(); ++i) {
+        storeLocaleData(loaded[i], flats[i], true);
+    }
+    const std::string cycle = resolveMessageReferences(loaded);
+    if (!cycle.empty()) {
+        restoreCatalog(snapshot);
+    }
+    rebuildKeyIndexes();
+    rebuildChain();
     clearFormatCache();
     clearTranslationCache();
+    if (!cycle.empty()) {
+        throw I18NError("load: " + cycle);
+    }
 }
 
 void I18N::setLocale(std::string_view locale) {
@@ -177,6 +440,7 @@ void I18N::setLocale(std::string_view locale) {
     } else {
         defaultConfig = baselineConfig_;
     }
+    rebuildChain();
     clearFormatCache();
     clearTranslationCache();
 }
@@ -189,12 +453,14 @@ void I18N::setLocale(const std::vector<std::string>& newLocales) {
     } else {
         defaultConfig = baselineConfig_;
     }
+    rebuildChain();
     clearFormatCache();
     clearTranslationCache();
 }
 
 void I18N::setFallbackLocale(std::string_view locale) {
     fallbackLocale = std::string(locale);
+    rebuildChain();
     clearFormatCache();
     clearTranslationCache();
 }
@@ -211,7 +477,7 @@ std::string I18N::getFallbackLocale() const noexcept {
     return fallbackLocale;
 }
 
-void I18N::flattenJson(const std::string& prefix, const json& node, std::unordered_map<std::string, std::string, StringHash, StringEqual>& flatMap) {
+void I18N::flattenJson(const std::string& prefix, const json& node, FlatStringMap<std::string>& flatMap) {
     for (auto it = node.begin(); it != node.end(); ++it) {
         if (it.key() == "_formats") continue;
 
@@ -247,7 +513,7 @@ void I18N::flattenJson(const std::string& prefix, const json& node, std::unorder
     }
 }
 
-void I18N::flattenJson(const std::string& prefix, json&& node, std::unordered_map<std::string, std::string, StringHash, StringEqual>& flatMap) {
+void I18N::flattenJson(const std::string& prefix, json&& node, FlatStringMap<std::string>& flatMap) {
     for (auto it = node.begin(); it != node.end(); ++it) {
         if (it.key() == "_formats") continue;
 
@@ -291,12 +557,570 @@ const std::string* I18N::getTranslationData(std::string_view key, std::string_vi
         return nullptr;
     }
 
-    auto keyIt = localeIt->second.find(key);
-    if (keyIt == localeIt->second.end()) {
+    const size_t keyId = findKeyId(key);
+    if (keyId == keyIndex_.npos) {
         return nullptr;
     }
+    return localeIt->second.value(static_cast<uint32_t>(keyId));
+}
+
+size_t I18N::findKeyId(std::string_view key) const noexcept {
+    return findKeyId(key, keyIndex_.hashOf(key));
+}
+
+size_t I18N::findKeyId(std::string_view key, size_t hash) const noexcept {
+    // Most composite probes (key.few, key.5, ...) and unknown keys miss:
+    // reject them with the filter before probing the index
+    if (!keyFilter_.mayContain(hash)) {
+        return keyIndex_.npos;
+    }
+    return keyIndex_.findIndex(key, hash);
+}
+
+const std::string* I18N::resolveInChain(size_t keyId) const noexcept {
+    if (activeMaterialized_) {
+        return (*activeMaterialized_)[keyId];
+    }
+    return walkChain(keyId);
+}
+
+const std::string* I18N::walkChain(size_t keyId) const noexcept {
+    const uint32_t id = static_cast<uint32_t>(keyId);
+    const uint32_t otherId = keyIndex_.entryAt(keyId).value.otherId;
+    for (const auto& link : chain_) {
+        if (const std::string* val = link.column->value(id)) {
+            return val;
+        }
+        // Fallback: key.other (for plural keys called without count)
+        if (const std::string* val = link.column->value(otherId)) {
+            return val;
+        }
+    }
+    return nullptr;
+}
+
+// Length of `base` when `key` is an exact-count form "<base>.<integer>",
+// otherwise npos
+static size_t countFormBaseLength(std::string_view key) {
+    const size_t dot = key.rfind('.');
+    if (dot == std::string_view::npos || dot == 0) {
+        return std::string_view::npos;
+    }
+    std::string_view suffix = key.substr(dot + 1);
+    if (!suffix.empty() && suffix.front() == '-') {
+        suffix.remove_prefix(1);
+    }
+    if (suffix.empty() || !std::all_of(suffix.begin(), suffix.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+        return std::string_view::npos;
+    }
+    return dot;
+}
+
+uint32_t I18N::internKey(std::string_view key) {
+    size_t index = keyIndex_.findIndex(key);
+    if (index != keyIndex_.npos) {
+        return static_cast<uint32_t>(index);
+    }
+    if (keyIndex_.size() >= kNoEntry) {
+        throw I18NError("Too many translation keys");
+    }
+    index = keyIndex_.size();
+    keyIndex_[key];
+
+    // Intern the base of "<key>.other" too, so tr(key) finds it by id
+    constexpr std::string_view kOtherSuffix = ".other";
+    if (key.size() > kOtherSuffix.size() && key.ends_with(kOtherSuffix)) {
+        const uint32_t baseId = internKey(key.substr(0, key.size() - kOtherSuffix.size()));
+        keyIndex_.entryAt(baseId).value.otherId = static_cast<uint32_t>(index);
+        return static_cast<uint32_t>(index);
+    }
+
+    // Intern the base of "<key>.<count>" so rebuildKeyIndexes() can flag it
+    const size_t baseLength = countFormBaseLength(key);
+    if (baseLength != std::string_view::npos) {
+        internKey(key.substr(0, baseLength));
+    }
+    return static_cast<uint32_t>(index);
+}
+
+void I18N::storeLocaleData(const std::string& locale, FlatStringMap<std::string>& flat, bool replace) {
+    // Materialized tables point into the value pools; the caller's
+    // rebuildChain() re-materializes the active chain if enabled
+    activeMaterialized_ = nullptr;
+    materializedChains_.clear();
+
+    LocaleColumn& column = localesData[locale];
+    if (replace) {
+        column.slots.clear();
+        column.values.clear();
+        column.links.clear();
+    }
+    column.values.reserve(column.values.size() + flat.size());
+
+    MessageReference ref;
+    for (auto& entry : flat) {
+        const uint32_t id = internKey(entry.key);
+        if (id >= column.slots.size()) {
+            column.slots.resize(keyIndex_.size(), kNoEntry);
+        }
+        if (nextMessageReference(entry.value, 0, ref)) {
+            column.links[id].clear(); // the stored value is its own source
+        } else if (!column.links.empty()) {
+            column.links.erase(id);
+        }
+        uint32_t& slot = column.slots[id];
+        if (slot == kNoEntry) {
+            slot = static_cast<uint32_t>(column.values.size());
+            column.values.push_back(std::move(entry.value));
+        } else {
+            column.values[slot] = std::move(entry.value);
+        }
+    }
+
+    column.slots.shrink_to_fit();
+    column.values.shrink_to_fit();
+    keyIndex_.shrinkToFit();
+}
+
+I18N::CatalogSnapshot I18N::snapshotFormats(const std::vector<std::string>& loaded) const {
+    CatalogSnapshot snapshot;
+    snapshot.defaultConfig = defaultConfig;
+    for (const auto& locale : loaded) {
+        auto it = formatConfigs.find(locale);
+        snapshot.formatConfigs.emplace_back(locale, it == formatConfigs.end() ? std::nullopt : std::optional(it->second));
+    }
+    return snapshot;
+}
+
+void I18N::snapshotColumns(CatalogSnapshot& snapshot, const std::vector<std::string>& loaded) const {
+    auto isLoaded = [&](std::string_view locale) {
+        return std::find(loaded.begin(), loaded.end(), locale) != loaded.end();
+    };
+    for (const auto& [locale, column] : localesData) {
+        const auto ancestry = getLocaleAncestry(locale);
+        if (std::any_of(ancestry.begin(), ancestry.end(), isLoaded)) {
+            snapshot.columns.emplace_back(locale, column);
+        }
+    }
+    for (const auto& locale : loaded) {
+        if (!localesData.count(locale)) {
+            snapshot.columns.emplace_back(locale, std::nullopt);
+        }
+    }
+}
+
+void I18N::restoreCatalog(CatalogSnapshot& snapshot) {
+    // Keys interned by the undone load stay in keyIndex_ without a value,
+    // like keys emptied by a reload
+    for (auto& [locale, column] : snapshot.columns) {
+        if (column) {
+            localesData[locale] = std::move(*column);
+        } else {
+            localesData.erase(locale);
+        }
+    }
+    for (auto& [locale, config] : snapshot.formatConfigs) {
+        if (config) {
+            formatConfigs[locale] = std::move(*config);
+        } else {
+            formatConfigs.erase(locale);
+        }
+    }
+    defaultConfig = std::move(snapshot.defaultConfig);
+}
+
+std::string I18N::resolveMessageReferences(const std::vector<std::string>& loaded) {
+    auto isLoaded = [&](std::string_view locale) {
+        return std::find(loaded.begin(), loaded.end(), locale) != loaded.end();
+    };
+    // Ancestors first, so a reference from en-US into en reads en's
+    // already-expanded value
+    std::vector<std::pair<const std::string*, LocaleColumn*>> linked;
+    for (auto& [locale, column] : localesData) {
+        if (column.links.empty()) {
+            continue;
+        }
+        const auto ancestry = getLocaleAncestry(locale);
+        if (std::any_of(ancestry.begin(), ancestry.end(), isLoaded)) {
+            linked.emplace_back(&locale, &column);
+        }
+    }
+    std::sort(linked.begin(), linked.end(), [](const auto& a, const auto& b) {
+        return std::count(a.first->begin(), a.first->end(), '-') < std::count(b.first->begin(), b.first->end(), '-');
+    });
+
+    // A value being expanded: its source, rebuilt from the stored value and
+    // splices, and the expansion written so far
+    struct Frame {
+        uint32_t id;
+        std::string source;
+        size_t pos = 0;
+        std::string text;
+        std::vector<MessageSplice> splices;
+    };
+
+    std::string cycle;
+    for (auto& [locale, column] : linked) {
+        const bool reportCycles = isLoaded(*locale);
+        // A referenced key is looked up in the locale itself, then its
+        // ancestors (en-US -> en); the fallback locale can change later, so
+        // it is not consulted
+        std::vector<const LocaleColumn*> lookup;
+        for (const auto& name : getLocaleAncestry(*locale)) {
+            auto it = localesData.find(name);
+            if (it != localesData.end()) {
+                lookup.push_back(&it->second);
+            }
+        }
+
+        auto open = [&](uint32_t id) {
+            Frame frame{id, {}, 0, {}, {}};
+            const std::string& value = column->values[column->slots[id]];
+            size_t pos = 0;
+            for (const MessageSplice& splice : column->links.at(id)) {
+                frame.source.append(value, pos, splice.offset - pos);
+                frame.source.append(splice.call ? "$t(" : "@:");
+                frame.source.append(keyIndex_.entryAt(splice.refId).key);
+                if (splice.call) {
+                    frame.source.push_back(')');
+                }
+                pos = splice.offset + splice.length;
+            }
+            frame.source.append(value, pos, std::string::npos);
+            frame.text.reserve(frame.source.size());
+            return frame;
+        };
+
+        // Depth-first with an explicit stack, so long "@:" chains cannot
+        // overflow the call stack. A frame pauses at a reference to a value
+        // not yet expanded and resumes at the same reference once it is.
+        std::unordered_map<uint32_t, bool> done; // false while being expanded
+        std::vector<Frame> stack;
+        for (const auto& [rootId, rootSplices] : column->links) {
+            if (done.count(rootId)) {
+                continue;
+            }
+            done[rootId] = false;
+            stack.push_back(open(rootId));
+            while (!stack.empty()) {
+                Frame& frame = stack.back();
+                MessageReference ref;
+                uint32_t pending = kNoEntry;
+                while (nextMessageReference(frame.source, frame.pos, ref)) {
+                    frame.text.append(frame.source, frame.pos, ref.begin - frame.pos);
+                    frame.pos = ref.begin;
+                    const size_t refIndex = keyIndex_.findIndex(ref.key);
+                    const uint32_t refId = refIndex == keyIndex_.npos ? kNoEntry : static_cast<uint32_t>(refIndex);
+                    const std::string_view written(frame.source.data() + ref.begin, ref.end - ref.begin);
+                    frame.pos = ref.end;
+                    if (refId != kNoEntry && column->value(refId) && column->links.count(refId)) {
+                        auto state = done.find(refId);
+                        if (state == done.end()) {
+                            frame.pos = ref.begin;
+                            done[refId] = false;
+                            pending = refId;
+                            break;
+                        }
+                        if (!state->second) {
+                            if (cycle.empty() && reportCycles) {
+                                cycle = "Circular message reference in locale '" + *locale + "': ";
+                                auto it = std::find_if(stack.begin(), stack.end(), [&](const Frame& f) { return f.id == refId; });
+                                for (; it != stack.end(); ++it) {
+                                    cycle += keyIndex_.entryAt(it->id).key + " -> ";
+                                }
+                                cycle += keyIndex_.entryAt(refId).key;
+                            }
+                            frame.text.append(written);
+                            continue;
+                        }
+                    }
+                    const std::string* target = nullptr;
+                    for (const LocaleColumn* candidate : lookup) {
+                        if ((target = candidate->value(refId)) != nullptr) {
+                            break;
+                        }
+                    }
+                    if (target) {
+                        frame.splices.push_back(MessageSplice{static_cast<uint32_t>(frame.text.size()),
+                            static_cast<uint32_t>(target->size()), refId, written.front() == '$'});
+                        frame.text.append(*target);
+                    } else {
+                        frame.text.append(written); // unknown key: keep verbatim
+                    }
+                }
+                if (pending != kNoEntry) {
+                    stack.push_back(open(pending));
+                    continue;
+                }
+                frame.text.append(frame.source, frame.pos, std::string::npos);
+                frame.text.shrink_to_fit();
+                column->values[column->slots[frame.id]] = std::move(frame.text);
+                frame.splices.shrink_to_fit();
+                column->links[frame.id] = std::move(frame.splices);
+                done[frame.id] = true;
+                stack.pop_back();
+            }
+        }
+    }
+    return cycle;
+}
+
+void I18N::rebuildKeyIndexes() {
+    ++catalogGeneration_;
+    bundleCache_.clear();
+
+    keyFilter_.reset(keyIndex_.size());
+    for (const auto& entry : keyIndex_) {
+        keyFilter_.insert(entry.hash);
+    }
+
+    // Trie over keys that have a value somewhere (bases interned only for
+    // their ".other" form, or emptied by a reload, are left out)
+    std::vector<bool> translated(keyIndex_.size(), false);
+    for (const auto& [name, column] : localesData) {
+        for (size_t id = 0; id < column.slots.size(); ++id) {
+            if (column.slots[id] != kNoEntry) {
+                translated[id] = true;
+            }
+        }
+    }
+    // "<key>.<count>" with a value makes trPlural(key) depend on the exact
+    // count; recomputed here so a reload that drops such forms clears it
+    for (size_t id = 0; id < keyIndex_.size(); ++id) {
+        keyIndex_.entryAt(id).value.hasCountForms = false;
+    }
+    std::vector<uint32_t> ids;
+    ids.reserve(keyIndex_.size());
+    for (size_t id = 0; id < translated.size(); ++id) {
+        if (translated[id]) {
+            ids.push_back(static_cast<uint32_t>(id));
+            const std::string_view key = keyIndex_.entryAt(id).key;
+            const size_t baseLength = countFormBaseLength(key);
+            if (baseLength != std::string_view::npos) {
+                keyIndex_.entryAt(findKeyId(key.substr(0, baseLength))).value.hasCountForms = true;
+            }
+        }
+    }
+
+    // Segment-wise order ('.' sorts before every other byte) keeps each
+    // subtree contiguous: "a", "a.b", "a-c" rather than "a", "a-c", "a.b"
+    auto rank = [](char c) { return c == '.' ? 0u : static_cast<unsigned char>(c) + 1u; };
+    std::sort(ids.begin(), ids.end(), [&](uint32_t lhs, uint32_t rhs) {
+        const std::string& a = keyIndex_.entryAt(lhs).key;
+        const std::string& b = keyIndex_.entryAt(rhs).key;
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(),
+            [&](char x, char y) { return rank(x) < rank(y); });
+    });
+
+    keyTrie_.assign(1, TrieNode{});
+    trieSegments_.clear();
+    std::vector<size_t> path{0}; // open nodes from the root down
+    for (uint32_t id : ids) {
+        std::string_view key = keyIndex_.entryAt(id).key;
+        size_t depth = 1;
+        size_t pos = 0;
+        while (true) {
+            const size_t dot = key.find('.', pos);
+            const std::string_view segment = key.substr(pos, dot == std::string_view::npos ? std::string_view::npos : dot - pos);
+            if (depth < path.size()) {
+                const TrieNode& open = keyTrie_[path[depth]];
+                if (std::string_view(trieSegments_).substr(open.segmentOffset, open.segmentLength) == segment) {
+                    ++depth;
+                    if (dot == std::string_view::npos) break;
+                    pos = dot + 1;
+                    continue;
+                }
+                // Diverged: close the open nodes below this depth
+                for (size_t i = path.size(); i-- > depth;) {
+                    keyTrie_[path[i]].subtreeEnd = static_cast<uint32_t>(keyTrie_.size());
+                }
+                path.resize(depth);
+            }
+            TrieNode node;
+            node.segmentOffset = static_cast<uint32_t>(trieSegments_.size());
+            node.segmentLength = static_cast<uint32_t>(segment.size());
+            trieSegments_.append(segment);
+            path.push_back(keyTrie_.size());
+            keyTrie_.push_back(node);
+            ++depth;
+            if (dot == std::string_view::npos) break;
+            pos = dot + 1;
+        }
+        // The key's own node is the deepest one it touched
+        if (depth < path.size()) {
+            for (size_t i = path.size(); i-- > depth;) {
+                keyTrie_[path[i]].subtreeEnd = static_cast<uint32_t>(keyTrie_.size());
+            }
+            path.resize(depth);
+        }
+        keyTrie_[path.back()].keyId = id;
+    }
+    for (size_t nodeIndex : path) {
+        keyTrie_[nodeIndex].subtreeEnd = static_cast<uint32_t>(keyTrie_.size());
+    }
+    keyTrie_.shrink_to_fit();
+    trieSegments_.shrink_to_fit();
+
+    // Variant tables: every node whose children are all leaves in at least
+    // one locale, i.e. some locale has a value directly below it and none
+    // deeper. `open` holds the enclosing nodes' subtree ends and the base
+    // length before each
+    variantIndex_.clear();
+    variantForms_.clear();
+    for (auto& [name, column] : localesData) {
+        column.variants.clear();
+    }
+    auto leafObjectIn = [&](const LocaleColumn& column, size_t node) {
+        bool hasForm = false;
+        for (size_t child = node + 1; child < keyTrie_[node].subtreeEnd; child = keyTrie_[child].subtreeEnd) {
+            hasForm = hasForm || column.value(keyTrie_[child].keyId);
+            for (size_t below = child + 1; below < keyTrie_[child].subtreeEnd; ++below) {
+                if (column.value(keyTrie_[below].keyId)) {
+                    return false;
+                }
+            }
+        }
+        return hasForm;
+    };
+    std::string base;
+    std::vector<std::pair<uint32_t, size_t>> open;
+    for (size_t node = 1; node < keyTrie_.size(); ++node) {
+        while (!open.empty() && open.back().first <= node) {
+            base.resize(open.back().second);
+            open.pop_back();
+        }
+        const TrieNode& current = keyTrie_[node];
+        open.emplace_back(current.subtreeEnd, base.size());
+        if (!base.empty()) {
+            base.push_back('.');
+        }
+        base.append(trieSegments_, current.segmentOffset, current.segmentLength);
+        if (current.subtreeEnd == node + 1) {
+            continue;
+        }
+
+        bool variantSomewhere = false;
+        for (const auto& [name, column] : localesData) {
+            if (leafObjectIn(column, node)) {
+                variantSomewhere = true;
+                break;
+            }
+        }
+        if (!variantSomewhere) {
+            continue;
+        }
+        VariantRange range;
+        range.id = static_cast<uint32_t>(variantIndex_.size());
+        range.begin = static_cast<uint32_t>(variantForms_.size());
+        for (size_t child = node + 1; child < current.subtreeEnd; child = keyTrie_[child].subtreeEnd) {
+            const TrieNode& form = keyTrie_[child];
+            if (form.keyId != kNoEntry) {
+                variantForms_.push_back(VariantForm{form.segmentOffset, form.segmentLength, form.keyId});
+            }
+        }
+        range.end = static_cast<uint32_t>(variantForms_.size());
+        variantIndex_[base] = range;
+        for (auto& [name, column] : localesData) {
+            column.variants.push_back(leafObjectIn(column, node));
+        }
+    }
+    variantIndex_.shrinkToFit();
+    variantForms_.shrink_to_fit();
+}
+
+uint32_t I18N::findVariant(const VariantRange& range, std::string_view value) const noexcept {
+    for (uint32_t i = range.begin; i < range.end; ++i) {
+        const VariantForm& form = variantForms_[i];
+        if (std::string_view(trieSegments_).substr(form.segmentOffset, form.segmentLength) == value) {
+            return form.keyId;
+        }
+    }
+    return kNoEntry;
+}
+
+size_t I18N::findTrieNode(std::string_view prefix) const noexcept {
+    if (keyTrie_.empty()) {
+        return keyIndex_.npos;
+    }
+    if (!prefix.empty() && prefix.back() == '.') {
+        prefix.remove_suffix(1);
+    }
+    size_t node = 0;
+    if (prefix.empty()) {
+        return node;
+    }
+
+    size_t pos = 0;
+    while (true) {
+        const size_t dot = prefix.find('.', pos);
+        const std::string_view segment = prefix.substr(pos, dot == std::string_view::npos ? std::string_view::npos : dot - pos);
+        size_t child = node + 1;
+        const size_t end = keyTrie_[node].subtreeEnd;
+        while (child < end) {
+            const TrieNode& candidate = keyTrie_[child];
+            if (std::string_view(trieSegments_).substr(candidate.segmentOffset, candidate.segmentLength) == segment) {
+                break;
+            }
+            child = candidate.subtreeEnd;
+        }
+        if (child >= end) {
+            return keyIndex_.npos;
+        }
+        node = child;
+        if (dot == std::string_view::npos) {
+            return node;
+        }
+        pos = dot + 1;
+    }
+}
+
+void I18N::rebuildChain() {
+    chain_.clear();
+    for (auto& loc : getFallbacks(locales)) {
+        auto localeIt = localesData.find(loc);
+        if (localeIt != localesData.end()) {
+            const int rule = pluralRuleFor(loc);
+            const int ordinalRule = ordinalRuleFor(loc);
+            chain_.push_back(ChainLink{std::move(loc), &localeIt->second, rule, ordinalRule});
+        }
+    }
 
-    return &keyIt->second;
+    activeMaterialized_ = nullptr;
+    if (materializeFallbacks_) {
+        activateMaterializedChain();
+    }
+}
+
+void I18N::activateMaterializedChain() {
+    std::string signature;
+    for (const auto& link : chain_) {
+        signature.append(link.locale);
+        signature.push_back('\0');
+    }
+
+    auto [it, inserted] = materializedChains_.try_emplace(std::move(signature));
+    if (inserted) {
+        auto& table = it->second;
+        table.resize(keyIndex_.size());
+        for (size_t id = 0; id < table.size(); ++id) {
+            table[id] = walkChain(id);
+        }
+    }
+    activeMaterialized_ = &it->second;
+}
+
+size_t I18N::materializeFallbacks() {
+    materializeFallbacks_ = true;
+    activateMaterializedChain();
+    return materializedMemoryUsage();
+}
+
+size_t I18N::materializedMemoryUsage() const noexcept {
+    size_t bytes = 0;
+    for (const auto& [signature, table] : materializedChains_) {
+        bytes += table.capacity() * sizeof(const std::string*) + signature.capacity();
+    }
+    return bytes;
 }
 
 std::string I18N::interpolate(std::string_view text, const json& params) const {
@@ -431,50 +1255,56 @@ std::string I18N::interpolate(std::string_view text, const json& params) const {
     return std::move(interpolateBuf2_);
 }
 
-std::string I18N::interpolateArray(std::string_view text, std::span<const std::string> params) const {
+std::string I18N::interpolateArray(std::string_view text, const ParamList& params) const {
+    std::string result;
+    interpolateArrayInto(result, text, params);
+    return result;
+}
+
+void I18N::interpolateArrayInto(std::string& out, std::string_view text, const ParamList& params) const {
     if (params.empty() || text.empty()) {
-        return std::string(text);
+        out.append(text);
+        return;
     }
 
-    std::string result(text);
-
     // Replace numbered placeholders {0}, {1}, {2}, ... — manual scan replacing indexPattern regex
     interpolateBuf_.clear();
-    interpolateBuf_.reserve(result.size() + (result.size() >> 1));
+    interpolateBuf_.reserve(text.size() + (text.size() >> 1));
 
     size_t lastPos = 0;
-    const size_t len = result.size();
+    const size_t len = text.size();
 
     for (size_t i = 0; i < len; ++i) {
-        if (result[i] == '{') {
+        if (text[i] == '{') {
             // Scan for digits
             size_t j = i + 1;
-            while (j < len && result[j] >= '0' && result[j] <= '9') {
+            while (j < len && text[j] >= '0' && text[j] <= '9') {
                 ++j;
             }
-            if (j > i + 1 && j < len && result[j] == '}') {
+            if (j > i + 1 && j < len && text[j] == '}') {
                 // Parse index manually
                 int index = 0;
                 for (size_t k = i + 1; k < j; ++k) {
-                    index = index * 10 + (result[k] - '0');
+                    index = index * 10 + (text[k] - '0');
                 }
-                interpolateBuf_.append(result, lastPos, i - lastPos);
-                if (index >= 0 && index < static_cast<int>(params.size())) {
+                interpolateBuf_.append(text, lastPos, i - lastPos);
+                if (index >= 0 && static_cast<size_t>(index) < params.size()) {
                     interpolateBuf_.append(params[index]);
                 } else {
-                    interpolateBuf_.append(result, i, j - i + 1);
+                    interpolateBuf_.append(text, i, j - i + 1);
                 }
                 lastPos = j + 1;
                 i = j; // loop increments
             }
         }
     }
-    interpolateBuf_.append(result, lastPos, std::string::npos);
-    result = std::move(interpolateBuf_);
+    interpolateBuf_.append(text, lastPos, std::string_view::npos);
+    const std::string& result = interpolateBuf_;
 
-    // Replace unnumbered placeholders {} — manual scan replacing emptyBracePattern regex
-    interpolateBuf2_.clear();
-    interpolateBuf2_.reserve(result.size() + (result.size() >> 1));
+    // Replace unnumbered placeholders {} — manual scan replacing emptyBracePattern regex.
+    // Reserve only the template size: padding would push short results out of
+    // the small-string buffer.
+    out.reserve(out.size() + result.size());
 
     lastPos = 0;
     const size_t len2 = result.size();
@@ -482,19 +1312,17 @@ std::string I18N::interpolateArray(std::string_view text, std::span<const std::s
 
     for (size_t i = 0; i + 1 < len2; ++i) {
         if (result[i] == '{' && result[i + 1] == '}') {
-            interpolateBuf2_.append(result, lastPos, i - lastPos);
+            out.append(result, lastPos, i - lastPos);
             if (paramIndex < params.size()) {
-                interpolateBuf2_.append(params[paramIndex++]);
+                out.append(params[paramIndex++]);
             } else {
-                interpolateBuf2_.append("{}");
+                out.append("{}");
             }
             lastPos = i + 2;
             i += 1; // loop increments
         }
     }
-    interpolateBuf2_.append(result, lastPos, std::string::npos);
-
-    return std::move(interpolateBuf2_);
+    out.append(result, lastPos, std::string::npos);
 }
 
 std::string I18N::getLocaleRoot(std::string_view locale) const {
@@ -550,9 +1378,9 @@ std::vector<std::string> I18N::getFallbacks(const std::vector<std::string>& loca
     return result;
 }
 
-std::string I18N::getPluralForm(std::string_view locale, int count) const {
+int I18N::pluralRuleFor(std::string_view locale) const {
     std::string root = getLocaleRoot(locale);
-    
+
     // Plural rules lookup — constexpr sorted array, no heap allocation
     struct LocaleRule { std::string_view locale; int rule; };
     static constexpr std::array<LocaleRule, 32> localeRules = {{
@@ -565,428 +1393,1742 @@ std::string I18N::getPluralForm(std::string_view locale, int count) const {
         {"sv", 1},  {"uk", 5},
     }};
 
-    int rule = 1; // default to English-like
     for (const auto& lr : localeRules) {
-        if (lr.locale == root) { rule = lr.rule; break; }
+        if (lr.locale == root) {
+            return lr.rule;
+        }
     }
-    
+    return 1; // default to English-like
+}
+
+size_t I18N::pluralCategory(int rule, int count) noexcept {
+    enum : size_t { Zero, One, Two, Few, Many, Other };
+
     switch (rule) {
         case 1: // English and similar
-            return (count == 1) ? "one" : "other";
-            
+            return (count == 1) ? One : Other;
+
         case 5: // Russian and similar
             if (count % 10 == 1 && count % 100 != 11) {
-                return "one";
+                return One;
             } else if (count % 10 >= 2 && count % 10 <= 4 && (count % 100 < 12 || count % 100 > 14)) {
-                return "few";
+                return Few;
             } else if (count % 10 == 0 || (count % 10 >= 5 && count % 10 <= 9) || (count % 100 >= 11 && count % 100 <= 14)) {
-                return "many";
+                return Many;
             } else {
-                return "other";
+                return Other;
             }
-            
+
         case 21: // Polish
             if (count == 1) {
-                return "one";
+                return One;
             } else if (count % 10 >= 2 && count % 10 <= 4 && (count % 100 < 12 || count % 100 > 14)) {
-                return "few";
+                return Few;
             } else {
-                return "many";
+                return Many;
             }
-            
+
         case 7: // Czech and Slovak
             if (count == 1) {
-                return "one";
+                return One;
             } else if (count >= 2 && count <= 4) {
-                return "few";
+                return Few;
             } else {
-                return "other";
+                return Other;
             }
-            
+
         case 9: // French and similar
-            return count < 2 ? "one" : "other";
-            
+            return count < 2 ? One : Other;
+
         case 3: // Arabic
             if (count == 0) {
-                return "zero";
+                return Zero;
             } else if (count == 1) {
-                return "one";
+                return One;
             } else if (count == 2) {
-                return "two";
+                return Two;
             } else if (count % 100 >= 3 && count % 100 <= 10) {
-                return "few";
+                return Few;
             } else if (count % 100 >= 11 && count % 100 <= 99) {
-                return "many";
+                return Many;
             } else {
-                return "other";
+                return Other;
             }
-            
+
         default: // Default to English-like
-            return count == 1 ? "one" : "other";
+            return count == 1 ? One : Other;
     }
 }
 
-std::string I18N::translate(std::string_view key, const json& params) {
-    if (key.empty()) {
-        return "";
-    }
+int I18N::ordinalRuleFor(std::string_view locale) const {
+    std::string root = getLocaleRoot(locale);
 
-    const std::vector<std::string>* searchPtr = &locales;
-    std::vector<std::string> overriddenLocales;
-    if (params.contains("locale") && params["locale"].is_string()) {
-        overriddenLocales.reserve(locales.size() + 1);
-        overriddenLocales.push_back(params["locale"].get<std::string>());
-        overriddenLocales.insert(overriddenLocales.end(), locales.begin(), locales.end());
-        searchPtr = &overriddenLocales;
+    // Ordinal rules lookup, as in pluralRuleFor(); rule 0 has a single form
+    struct LocaleRule { std::string_view locale; int rule; };
+    static constexpr std::array<LocaleRule, 39> localeRules = {{
+        {"ar", 0},  {"be", 8},  {"bg", 0},  {"bs", 0},  {"ca", 6},
+        {"cs", 0},  {"da", 0},  {"de", 0},  {"el", 0},  {"en", 1},
+        {"eo", 0},  {"es", 0},  {"et", 0},  {"fi", 0},  {"fo", 0},
+        {"fr", 2},  {"he", 0},  {"hr", 0},  {"hu", 5},  {"it", 3},
+        {"ja", 0},  {"ko", 0},  {"ms", 2},  {"nb", 0},  {"nl", 0},
+        {"nn", 0},  {"no", 0},  {"pl", 0},  {"pt", 0},  {"ro", 2},
+        {"ru", 0},  {"sh", 0},  {"sk", 0},  {"sr", 0},  {"sv", 4},
+        {"tr", 0},  {"uk", 7},  {"vi", 2},  {"zh", 0},
+    }};
+
+    for (const auto& lr : localeRules) {
+        if (lr.locale == root) {
+            return lr.rule;
+        }
     }
+    return 0; // unknown: a single "other" form
+}
 
-    std::vector<std::string> fallbacks = getFallbacks(*searchPtr);
-    std::string compositeKey;
-    compositeKey.reserve(key.size() + 12);
+size_t I18N::ordinalCategory(int rule, int n) noexcept {
+    enum : size_t { Zero, One, Two, Few, Many, Other };
+    const unsigned v = n < 0 ? 0u - static_cast<unsigned>(n) : static_cast<unsigned>(n);
+    const unsigned mod10 = v % 10;
+    const unsigned mod100 = v % 100;
 
-    for (const auto& loc : fallbacks) {
-        // Direct lookup
-        const std::string* val = getTranslationData(key, loc);
+    switch (rule) {
+        case 1: // English: 1st, 2nd, 3rd, 4th, 11th, 21st
+            if (mod10 == 1 && mod100 != 11) {
+                return One;
+            } else if (mod10 == 2 && mod100 != 12) {
+                return Two;
+            } else if (mod10 == 3 && mod100 != 13) {
+                return Few;
+            } else {
+                return Other;
+            }
+
+        case 2: // French and similar: 1er, 2e
+            return v == 1 ? One : Other;
+
+        case 3: // Italian: l'8°, l'11°
+            return (v == 8 || v == 11 || v == 80 || v == 800) ? Many : Other;
+
+        case 4: // Swedish: 1:a, 2:a, 3:e
+            return ((mod10 == 1 || mod10 == 2) && mod100 != 11 && mod100 != 12) ? One : Other;
+
+        case 5: // Hungarian: 1-jén, 5-jén
+            return (v == 1 || v == 5) ? One : Other;
+
+        case 6: // Catalan: 1r, 2n, 3r, 4t, 5è
+            if (v == 1 || v == 3) {
+                return One;
+            } else if (v == 2) {
+                return Two;
+            } else if (v == 4) {
+                return Few;
+            } else {
+                return Other;
+            }
+
+        case 7: // Ukrainian
+            return (mod10 == 3 && mod100 != 13) ? Few : Other;
+
+        case 8: // Belarusian
+            return ((mod10 == 2 || mod10 == 3) && mod100 != 12 && mod100 != 13) ? Few : Other;
+
+        default: // A single form
+            return Other;
+    }
+}
+
+size_t I18N::linkCategory(const ChainLink& link, int count, bool ordinal) noexcept {
+    return ordinal ? ordinalCategory(link.ordinalRule, count) : pluralCategory(link.pluralRule, count);
+}
+
+std::string_view I18N::getPluralForm(std::string_view locale, int count) const {
+    return kPluralCategories[pluralCategory(pluralRuleFor(locale), count)];
+}
+
+std::string I18N::translate(std::string_view key, const json& params) {
+    if (key.empty()) {
+        return "";
+    }
+    if (!params.is_object()) {
+        const std::string* text = resolveTranslateTemplate(key, params);
+        return text ? interpolate(*text, params) : std::string(key);
+    }
+
+    // Selector key: key \0 count, then every string param. String params can
+    // pick a variant ("key.<value>") or override the locale, so all of them
+    // take part; other params only matter if the template references them.
+    // A string value containing '%' or '<' can splice a new %<name> reference
+    // into the first interpolation pass, so such calls are not cached.
+    std::string& cacheKey = cacheKeyBuf_;
+    cacheKey.assign(key);
+    cacheKey.push_back('\0');
+    auto countIt = params.find("count");
+    if (countIt != params.end() && countIt->is_number()) {
+        const int count = countIt->get<int>();
+        cacheKey.push_back('c');
+        cacheKey.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+    for (auto it = params.begin(); it != params.end(); ++it) {
+        if (!it.value().is_string()) {
+            continue;
+        }
+        const auto& value = it.value().get_ref<const json::string_t&>();
+        if (value.find_first_of("%<") != std::string::npos) {
+            const std::string* text = resolveTranslateTemplate(key, params);
+            return text ? interpolate(*text, params) : std::string(key);
+        }
+        appendVarint(cacheKey, it.key().size());
+        cacheKey.append(it.key());
+        appendParamKey(cacheKey, it.value());
+    }
+
+    const TranslateTemplate* entry = translateTemplates_.find(cacheKey);
+    if (!entry) {
+        if (translateTemplates_.size() + translateCache_.size() >= kTranslateCacheLimit) {
+            translateTemplates_.clear();
+            translateCache_.clear();
+        }
+        TranslateTemplate resolved;
+        const std::string* text = resolveTranslateTemplate(key, params);
+        if (text) {
+            // Collect the %{name} / %<name> references to non-string params
+            for (size_t i = 0; i + 1 < text->size(); ++i) {
+                const char open = (*text)[i + 1];
+                if ((*text)[i] != '%' || (open != '{' && open != '<')) {
+                    continue;
+                }
+                size_t j = i + 2;
+                while (j < text->size() && (std::isalnum(static_cast<unsigned char>((*text)[j]))
+                                            || (*text)[j] == '_' || (*text)[j] == '.')) {
+                    ++j;
+                }
+                std::string_view name(text->data() + i + 2, j - i - 2);
+                auto param = params.find(name);
+                if (!name.empty() && (param == params.end() || !param->is_string())
+                    && std::find(resolved.refs.begin(), resolved.refs.end(), name) == resolved.refs.end()) {
+                    resolved.refs.emplace_back(name);
+                }
+                i = j - 1;
+            }
+            resolved.text = resolved.refs.empty() ? interpolate(*text, params) : *text;
+        } else {
+            resolved.text.assign(key);
+        }
+        entry = &(translateTemplates_[cacheKey] = std::move(resolved));
+    }
+    if (entry->refs.empty()) {
+        return entry->text;
+    }
+
+    cacheKey.push_back('\1');
+    for (const auto& name : entry->refs) {
+        auto param = params.find(name);
+        if (param == params.end()) {
+            cacheKey.push_back('-');
+        } else if (!appendParamKey(cacheKey, *param)) {
+            return interpolate(entry->text, params);
+        }
+    }
+    if (const std::string* cached = translateCache_.find(cacheKey)) {
+        return *cached;
+    }
+    std::string result = interpolate(entry->text, params);
+    if (translateTemplates_.size() + translateCache_.size() >= kTranslateCacheLimit) {
+        translateTemplates_.clear();
+        translateCache_.clear();
+    }
+    translateCache_[cacheKey] = result;
+    return result;
+}
+
+const std::string* I18N::resolveTranslateTemplate(std::string_view key, const json& params) const {
+    const std::vector<std::string>* searchPtr = &locales;
+    std::vector<std::string> overriddenLocales;
+    if (params.contains("locale") && params["locale"].is_string()) {
+        overriddenLocales.reserve(locales.size() + 1);
+        overriddenLocales.push_back(params["locale"].get<std::string>());
+        overriddenLocales.insert(overriddenLocales.end(), locales.begin(), locales.end());
+        searchPtr = &overriddenLocales;
+    }
+
+    std::vector<std::string> fallbacks = getFallbacks(*searchPtr);
+    std::string compositeKey;
+    compositeKey.reserve(key.size() + 12);
+
+    // Variant selection: an explicit "select" param names the one param whose
+    // value picks the form; otherwise every string param is tried in order.
+    // The matching form's key id is the same in every locale.
+    uint32_t variantId = kNoEntry;
+    const VariantRange* forms = variantIndex_.find(key);
+    if (forms) {
+        auto selectIt = params.find("select");
+        if (selectIt != params.end() && selectIt->is_string()) {
+            auto selected = params.find(selectIt->get_ref<const json::string_t&>());
+            if (selected != params.end() && selected->is_string()) {
+                variantId = findVariant(*forms, selected->get_ref<const json::string_t&>());
+            }
+        } else {
+            for (auto it = params.begin(); it != params.end() && variantId == kNoEntry; ++it) {
+                if (it.value().is_string()) {
+                    variantId = findVariant(*forms, it.value().get_ref<const json::string_t&>());
+                }
+            }
+        }
+    }
+
+    for (const auto& loc : fallbacks) {
+        // Direct lookup
+        const std::string* val = getTranslationData(key, loc);
         if (val) {
-            return interpolate(*val, params);
+            return val;
         }
 
         // Plural path: if params has "count", build key.pluralForm
         if (params.contains("count") && params["count"].is_number()) {
             int count = params["count"].get<int>();
-            std::string pluralForm = getPluralForm(loc, count);
+            std::string_view pluralForm = getPluralForm(loc, count);
 
             compositeKey.assign(key);
             compositeKey.push_back('.');
             compositeKey.append(pluralForm);
             val = getTranslationData(compositeKey, loc);
-            if (val) return interpolate(*val, params);
+            if (val) return val;
 
             compositeKey.assign(key);
             compositeKey.append(".other");
             val = getTranslationData(compositeKey, loc);
-            if (val) return interpolate(*val, params);
+            if (val) return val;
 
             compositeKey.assign(key);
             compositeKey.push_back('.');
             compositeKey.append(std::to_string(count));
             val = getTranslationData(compositeKey, loc);
-            if (val) return interpolate(*val, params);
+            if (val) return val;
         } else {
-            // Variant path: try key.paramValue for each param
-            for (auto it = params.begin(); it != params.end(); ++it) {
-                if (it.value().is_string()) {
-                    compositeKey.assign(key);
-                    compositeKey.push_back('.');
-                    compositeKey.append(it.value().get_ref<const json::string_t&>());
-                    val = getTranslationData(compositeKey, loc);
-                    if (val) return interpolate(*val, params);
+            // Variant path: the selected form, if this locale has it and
+            // the key is a leaf object here
+            if (variantId != kNoEntry) {
+                auto localeIt = localesData.find(loc);
+                if (localeIt != localesData.end() && forms->id < localeIt->second.variants.size()
+                    && localeIt->second.variants[forms->id]) {
+                    val = localeIt->second.value(variantId);
+                    if (val) return val;
                 }
             }
             // Fallback to "other"
             compositeKey.assign(key);
             compositeKey.append(".other");
             val = getTranslationData(compositeKey, loc);
-            if (val) return interpolate(*val, params);
+            if (val) return val;
+        }
+    }
+
+    if (params.contains("default") && params["default"].is_string()) {
+        return &params["default"].get_ref<const json::string_t&>();
+    }
+
+    return nullptr;
+}
+
+std::string I18N::tr(std::string_view key) const {
+    return tr(key, std::span<const std::string>{});
+}
+
+std::string I18N::tr(std::string_view key, std::initializer_list<std::string_view> params) const {
+    return trImpl(key, ParamList(std::span<const std::string_view>{params.begin(), params.size()}));
+}
+
+std::string I18N::tr(std::string_view key, std::span<const std::string> params) const {
+    return trImpl(key, ParamList(params));
+}
+
+std::string I18N::tr(std::string_view key, std::span<const std::string_view> params) const {
+    return trImpl(key, ParamList(params));
+}
+
+std::string I18N::trImpl(std::string_view key, const ParamList& params) const {
+    if (key.empty()) {
+        return "";
+    }
+
+    // Build cache key: key \0 param1 \0 param2 ... (reuse member buffer so
+    // cache hits stay allocation-free)
+    std::string& cacheKey = cacheKeyBuf_;
+    cacheKey.assign(key);
+    for (size_t i = 0; i < params.size(); ++i) {
+        cacheKey.push_back('\0');
+        cacheKey.append(params[i]);
+    }
+
+    if (const std::string* cached = translationCache_.find(cacheKey)) {
+        return *cached;
+    }
+
+    const size_t keyId = findKeyId(key);
+    if (keyId != keyIndex_.npos) {
+        if (const std::string* val = resolveInChain(keyId)) {
+            std::string result = interpolateArray(*val, params);
+            translationCache_[cacheKey] = result;
+            return result;
+        }
+    }
+
+    // Cache the miss too, so a key absent from every locale is not re-resolved
+    // on each call; any catalog change clears the cache
+    noteCacheMiss();
+    std::string result(key);
+    translationCache_[cacheKey] = result;
+    return result;
+}
+
+// Counts a negative entry about to be stored, flushing the caches that hold
+// them once kNegativeCacheLimit is reached
+void I18N::noteCacheMiss() const {
+    if (negativeCacheEntries_ >= kNegativeCacheLimit) {
+        translationCache_.clear();
+        pluralCache_.clear();
+        negativeCacheEntries_ = 0;
+    }
+    ++negativeCacheEntries_;
+}
+
+std::string I18N::trPlural(std::string_view key, int count) const {
+    return trPlural(key, count, std::span<const std::string>{});
+}
+
+std::string I18N::trPlural(std::string_view key, int count, std::initializer_list<std::string_view> params) const {
+    return trPluralImpl(key, count, ParamList(std::span<const std::string_view>{params.begin(), params.size()}), false);
+}
+
+std::string I18N::trPlural(std::string_view key, int count, std::span<const std::string> params) const {
+    return trPluralImpl(key, count, ParamList(params), false);
+}
+
+std::string I18N::trPlural(std::string_view key, int count, std::span<const std::string_view> params) const {
+    return trPluralImpl(key, count, ParamList(params), false);
+}
+
+std::string I18N::trOrdinal(std::string_view key, int n) const {
+    return trOrdinal(key, n, std::span<const std::string>{});
+}
+
+std::string I18N::trOrdinal(std::string_view key, int n, std::initializer_list<std::string_view> params) const {
+    return trPluralImpl(key, n, ParamList(std::span<const std::string_view>{params.begin(), params.size()}), true);
+}
+
+std::string I18N::trOrdinal(std::string_view key, int n, std::span<const std::string> params) const {
+    return trPluralImpl(key, n, ParamList(params), true);
+}
+
+std::string I18N::trOrdinal(std::string_view key, int n, std::span<const std::string_view> params) const {
+    return trPluralImpl(key, n, ParamList(params), true);
+}
+
+std::string I18N::trPluralImpl(std::string_view key, int count, const ParamList& params, bool ordinal) const {
+    if (key.empty()) {
+        return "";
+    }
+
+    // The template depends on the count only through the plural category of
+    // each chain locale, so it is cached per (key, categories) — at most a
+    // handful of entries per key — and the count is substituted per call.
+    // Ordinal categories get their own marker.
+    std::string& cacheKey = cacheKeyBuf_;
+    cacheKey.assign(key);
+    cacheKey.append(ordinal ? std::string_view("\0O\0", 3) : std::string_view("\0C\0", 3));
+    for (const auto& link : chain_) {
+        cacheKey.push_back(static_cast<char>('0' + linkCategory(link, count, ordinal)));
+    }
+
+    PluralTemplate* pluralTemplate = pluralCache_.find(cacheKey);
+    if (!pluralTemplate) {
+        PluralTemplate resolved = resolvePluralTemplate(key, count, ordinal);
+        if (!resolved.perCount && !resolved.text) {
+            noteCacheMiss();
+        }
+        pluralTemplate = &(pluralCache_[cacheKey] = std::move(resolved));
+    }
+
+    if (!pluralTemplate->perCount && !pluralTemplate->text) {
+        return std::string(key);
+    }
+    std::string& joined = cacheKeyBuf_;
+    if (!pluralTemplate->perCount) {
+        // Repeating the previous count and params copies its result
+        joined.clear();
+        for (size_t i = 0; i < params.size(); ++i) {
+            joined.push_back('\0');
+            joined.append(params[i]);
+        }
+        if (pluralTemplate->hasLast && pluralTemplate->lastCount == count && pluralTemplate->lastParams == joined) {
+            return pluralTemplate->lastResult;
+        }
+    }
+
+    // The count is slot 0 of the params, followed by the caller's params
+    char countBuf[16];
+    const auto countEnd = std::to_chars(countBuf, countBuf + sizeof(countBuf), count).ptr;
+    const std::string_view countStr(countBuf, static_cast<size_t>(countEnd - countBuf));
+    const ParamList extendedParams = params.withLeading(countStr);
+
+    if (!pluralTemplate->perCount) {
+        pluralTemplate->hasLast = false;
+        pluralTemplate->lastResult.clear();
+        interpolateArrayInto(pluralTemplate->lastResult, *pluralTemplate->text, extendedParams);
+        pluralTemplate->lastCount = count;
+        pluralTemplate->lastParams.assign(joined);
+        pluralTemplate->hasLast = true;
+        return pluralTemplate->lastResult;
+    }
+
+    // Exact-count forms (key.0, key.5, ...) exist: cache rendered results per
+    // count. Cache key: key \0P\0 count \0 param1 \0 param2 ... (\0Q\0 for
+    // ordinals)
+    cacheKey.assign(key);
+    cacheKey.append(ordinal ? std::string_view("\0Q\0", 3) : std::string_view("\0P\0", 3));
+    cacheKey.append(countStr);
+    for (size_t i = 0; i < params.size(); ++i) {
+        cacheKey.push_back('\0');
+        cacheKey.append(params[i]);
+    }
+
+    if (const std::string* cached = translationCache_.find(cacheKey)) {
+        return *cached;
+    }
+
+    std::string compositeKey;
+    compositeKey.reserve(key.size() + 12);
+    const uint32_t baseId = static_cast<uint32_t>(findKeyId(key));
+    const uint32_t otherId = keyIndex_.entryAt(baseId).value.otherId;
+    compositeKey.assign(key);
+    compositeKey.push_back('.');
+    compositeKey.append(countStr);
+    const size_t countIndex = findKeyId(compositeKey);
+    const uint32_t countId = countIndex == keyIndex_.npos ? kNoEntry : static_cast<uint32_t>(countIndex);
+
+    for (const auto& link : chain_) {
+        compositeKey.assign(key);
+        compositeKey.push_back('.');
+        compositeKey.append(kPluralCategories[linkCategory(link, count, ordinal)]);
+        const size_t formIndex = findKeyId(compositeKey);
+        const uint32_t formId = formIndex == keyIndex_.npos ? kNoEntry : static_cast<uint32_t>(formIndex);
+
+        // Plural form, then "other", then the exact count, then the direct key
+        for (uint32_t id : {formId, otherId, countId, baseId}) {
+            if (const std::string* val = link.column->value(id)) {
+                std::string result = interpolateArray(*val, extendedParams);
+                translationCache_[cacheKey] = result;
+                return result;
+            }
+        }
+    }
+
+    // Negative entry, as in tr()
+    noteCacheMiss();
+    std::string result(key);
+    translationCache_[cacheKey] = result;
+    return result;
+}
+
+I18N::PluralTemplate I18N::resolvePluralTemplate(std::string_view key, int count, bool ordinal) const {
+    const size_t baseIndex = findKeyId(key);
+    if (baseIndex != keyIndex_.npos && keyIndex_.entryAt(baseIndex).value.hasCountForms) {
+        PluralTemplate result;
+        result.perCount = true;
+        return result;
+    }
+    const uint32_t baseId = baseIndex == keyIndex_.npos ? kNoEntry : static_cast<uint32_t>(baseIndex);
+    const uint32_t otherId = baseId == kNoEntry ? kNoEntry : keyIndex_.entryAt(baseId).value.otherId;
+
+    // Key ids are shared by all locales: probe each category key once, then
+    // walk the chain with array reads
+    std::array<uint32_t, kPluralCategories.size()> formIds;
+    std::array<bool, kPluralCategories.size()> formProbed{};
+    std::string compositeKey;
+    compositeKey.reserve(key.size() + 8);
+
+    for (const auto& link : chain_) {
+        const size_t category = linkCategory(link, count, ordinal);
+        if (!formProbed[category]) {
+            compositeKey.assign(key);
+            compositeKey.push_back('.');
+            compositeKey.append(kPluralCategories[category]);
+            const size_t formIndex = findKeyId(compositeKey);
+            formIds[category] = formIndex == keyIndex_.npos ? kNoEntry : static_cast<uint32_t>(formIndex);
+            formProbed[category] = true;
+        }
+
+        // Plural form (key.one, key.few, ...), then "other", then the direct
+        // key (a plain string with placeholders)
+        for (uint32_t id : {formIds[category], otherId, baseId}) {
+            if (const std::string* val = link.column->value(id)) {
+                PluralTemplate result;
+                result.text = val;
+                return result;
+            }
+        }
+    }
+    return PluralTemplate{};
+}
+
+// Pads the field that starts at `start` to |width| bytes
+static void padField(std::string& out, size_t start, int32_t width) {
+    const size_t target = static_cast<size_t>(width < 0 ? -static_cast<int64_t>(width) : width);
+    const size_t written = out.size() - start;
+    if (written >= target) {
+        return;
+    }
+    if (width > 0) {
+        out.insert(start, target - written, ' ');
+    } else {
+        out.append(target - written, ' ');
+    }
+}
+
+std::string I18N::trf(std::string_view key, std::initializer_list<FormatArg> args, Escape escape) const {
+    return trf(key, std::span<const FormatArg>{args.begin(), args.size()}, escape);
+}
+
+std::string I18N::trf(std::string_view key, std::span<const FormatArg> args, Escape escape) const {
+    std::string result;
+    trfInto(result, key, args, escape);
+    return result;
+}
+
+void I18N::trfInto(std::string& out, std::string_view key, std::span<const FormatArg> args, Escape escape) const {
+    if (key.empty()) {
+        return;
+    }
+    const CompiledTemplate& compiled = compiledTemplate(key, escape);
+    if (!compiled.text) {
+        appendEscaped(out, key, escape);
+        return;
+    }
+    renderTemplate(out, compiled, args, escape);
+}
+
+void I18N::trfSegments(SegmentedOutput& out, std::string_view key, std::span<const FormatArg> args, Escape escape) const {
+    out.clear();
+    trfSegmentsInto(out, key, args, escape);
+}
+
+void I18N::trfSegmentsInto(SegmentedOutput& out, std::string_view key, std::span<const FormatArg> args, Escape escape) const {
+    if (key.empty()) {
+        return;
+    }
+    const CompiledTemplate& compiled = compiledTemplate(key, escape);
+    if (!compiled.text) {
+        const size_t start = out.buffer_.size();
+        appendEscaped(out.buffer_, key, escape);
+        out.commitBuffer(start);
+        return;
+    }
+
+    // Same parts as renderTemplate(), but literals and plain string args are
+    // referenced where they live; only generated bytes go to the buffer
+    const std::string_view text = compiled.source();
+    for (const TemplatePart& part : compiled.parts) {
+        if (part.argIndex < 0 || static_cast<size_t>(part.argIndex) >= args.size()) {
+            out.appendView(text.substr(part.offset, part.length));
+            continue;
+        }
+        const FormatArg& arg = args[part.argIndex];
+        if (arg.kind() == FormatArg::Kind::String && part.width == 0 && escape == Escape::None) {
+            out.appendView(arg.text());
+            continue;
+        }
+        const size_t start = out.buffer_.size();
+        const std::string_view pattern = text.substr(part.patternOffset, part.patternLength);
+        if (escape == Escape::None) {
+            appendArg(out.buffer_, arg, part.type, pattern);
+            padField(out.buffer_, start, part.width);
+        } else if (arg.kind() == FormatArg::Kind::String && part.width == 0) {
+            appendEscaped(out.buffer_, arg.text(), escape);
+        } else {
+            std::string& field = interpolateBuf2_;
+            field.clear();
+            appendArg(field, arg, part.type, pattern);
+            padField(field, 0, part.width);
+            appendEscaped(out.buffer_, field, escape);
+        }
+        out.commitBuffer(start);
+    }
+}
+
+const I18N::CompiledTemplate& I18N::compiledTemplate(std::string_view key, Escape escape) const {
+    // Unescaped templates are cached by key; escaped ones by (mode, NUL, key)
+    std::string_view cacheKey = key;
+    if (escape != Escape::None) {
+        cacheKeyBuf_.assign(1, static_cast<char>(escape));
+        cacheKeyBuf_.push_back('\0');
+        cacheKeyBuf_.append(key);
+        cacheKey = cacheKeyBuf_;
+    }
+
+    const CompiledTemplate* compiled = templateCache_.find(cacheKey);
+    if (!compiled) {
+        CompiledTemplate fresh;
+        const size_t keyId = findKeyId(key);
+        if (keyId != keyIndex_.npos) {
+            if (const std::string* val = resolveInChain(keyId)) {
+                fresh = compileTemplate(*val, escape);
+            }
+        }
+        compiled = &(templateCache_[cacheKey] = std::move(fresh));
+    }
+    return *compiled;
+}
+
+I18N::CompiledTemplate I18N::compileTemplate(const std::string& text, Escape escape) {
+    CompiledTemplate compiled;
+    compiled.text = &text;
+
+    auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+    int32_t nextArg = 0; // for {} placeholders, counted apart from numbered ones
+    size_t literalStart = 0;
+    for (size_t open = text.find('{'); open != std::string::npos; open = text.find('{', open + 1)) {
+        const size_t close = text.find('}', open + 1);
+        if (close == std::string::npos) {
+            break;
+        }
+
+        // {index[,width][:type[:pattern]]}; anything else stays literal text
+        TemplatePart part;
+        size_t pos = open + 1;
+        if (pos < close && isDigit(text[pos])) {
+            int64_t index = 0;
+            while (pos < close && isDigit(text[pos]) && index <= INT32_MAX) {
+                index = index * 10 + (text[pos++] - '0');
+            }
+            if (index > INT32_MAX) {
+                continue;
+            }
+            part.argIndex = static_cast<int32_t>(index);
+        } else {
+            part.argIndex = -2; // resolved below, once the spec is known to be valid
+        }
+        if (pos < close && text[pos] == ',') {
+            ++pos;
+            const bool left = pos < close && text[pos] == '-';
+            if (left) {
+                ++pos;
+            }
+            if (pos >= close || !isDigit(text[pos])) {
+                continue;
+            }
+            int32_t width = 0;
+            while (pos < close && isDigit(text[pos]) && width < 10000) {
+                width = width * 10 + (text[pos++] - '0');
+            }
+            part.width = left ? -width : width;
+        }
+        if (pos < close && text[pos] == ':') {
+            ++pos;
+            const size_t typeEnd = std::min(text.find(':', pos), close);
+            const std::string_view type(text.data() + pos, typeEnd - pos);
+            if (type == "number") {
+                part.type = PlaceholderType::Number;
+            } else if (type == "price") {
+                part.type = PlaceholderType::Price;
+            } else if (type == "date") {
+                part.type = PlaceholderType::Date;
+            } else if (type == "compact") {
+                part.type = PlaceholderType::Compact;
+            } else if (type == "percent") {
+                part.type = PlaceholderType::Percent;
+            } else if (type == "ordinal") {
+                part.type = PlaceholderType::Ordinal;
+            } else {
+                continue;
+            }
+            // Dates take a pattern and prices an ISO 4217 code
+            const bool patterned = part.type == PlaceholderType::Price || part.type == PlaceholderType::Date;
+            if (patterned && typeEnd < close) {
+                part.patternOffset = static_cast<uint32_t>(typeEnd + 1);
+                part.patternLength = static_cast<uint32_t>(close - typeEnd - 1);
+            }
+            pos = patterned ? close : typeEnd;
+        }
+        if (pos != close) {
+            continue;
+        }
+        if (part.argIndex == -2) {
+            part.argIndex = nextArg++;
+        }
+
+        if (open > literalStart) {
+            TemplatePart literal;
+            literal.offset = static_cast<uint32_t>(literalStart);
+            literal.length = static_cast<uint32_t>(open - literalStart);
+            compiled.parts.push_back(literal);
+        }
+        part.offset = static_cast<uint32_t>(open);
+        part.length = static_cast<uint32_t>(close + 1 - open);
+        compiled.parts.push_back(part);
+        literalStart = close + 1;
+        open = close;
+    }
+    if (literalStart < text.size()) {
+        TemplatePart literal;
+        literal.offset = static_cast<uint32_t>(literalStart);
+        literal.length = static_cast<uint32_t>(text.size() - literalStart);
+        compiled.parts.push_back(literal);
+    }
+    compiled.parts.shrink_to_fit();
+
+    // Escape the catalog text now so rendering only escapes arguments.
+    // Parts are re-pointed into escapedText; patterns are copied raw.
+    if (escape != Escape::None) {
+        compiled.escapedText = std::make_unique<std::string>();
+        std::string& escaped = *compiled.escapedText;
+        escaped.reserve(text.size() + (text.size() >> 2));
+        for (TemplatePart& part : compiled.parts) {
+            const size_t offset = escaped.size();
+            appendEscaped(escaped, std::string_view(text).substr(part.offset, part.length), escape);
+            if (part.patternLength > 0) {
+                const size_t patternOffset = escaped.size();
+                escaped.append(text, part.patternOffset, part.patternLength);
+                part.patternOffset = static_cast<uint32_t>(patternOffset);
+            }
+            part.offset = static_cast<uint32_t>(offset);
+            part.length = static_cast<uint32_t>(escaped.size() - offset - part.patternLength);
+        }
+        escaped.shrink_to_fit();
+    }
+    return compiled;
+}
+
+void I18N::renderTemplate(std::string& out, const CompiledTemplate& compiled, std::span<const FormatArg> args,
+                          Escape escape) const {
+    const std::string_view text = compiled.source();
+    out.reserve(out.size() + text.size());
+    for (const TemplatePart& part : compiled.parts) {
+        if (part.argIndex < 0 || static_cast<size_t>(part.argIndex) >= args.size()) {
+            out.append(text.substr(part.offset, part.length));
+            continue;
+        }
+        const FormatArg& arg = args[part.argIndex];
+        const std::string_view pattern = text.substr(part.patternOffset, part.patternLength);
+        if (escape == Escape::None) {
+            const size_t start = out.size();
+            appendArg(out, arg, part.type, pattern);
+            padField(out, start, part.width);
+        } else if (arg.kind() == FormatArg::Kind::String && part.width == 0) {
+            appendEscaped(out, arg.text(), escape);
+        } else {
+            // Format into scratch, then escape the field as it is copied out
+            std::string& field = interpolateBuf2_;
+            field.clear();
+            appendArg(field, arg, part.type, pattern);
+            padField(field, 0, part.width);
+            appendEscaped(out, field, escape);
+        }
+    }
+}
+
+void I18N::appendArg(std::string& out, const FormatArg& arg, PlaceholderType type, std::string_view pattern) const {
+    using Kind = FormatArg::Kind;
+    const bool numeric = arg.kind() == Kind::Integer || arg.kind() == Kind::Float;
+    const bool time = arg.kind() == Kind::Time || arg.kind() == Kind::Timestamp;
+
+    if (type == PlaceholderType::Number && numeric) {
+        appendNumber(out, arg.number(), defaultConfig.number);
+        return;
+    }
+    if (type == PlaceholderType::Compact && numeric) {
+        appendCompact(out, arg.kind() == Kind::Integer ? arg.integer() : std::llround(arg.number()));
+        return;
+    }
+    if (type == PlaceholderType::Percent && numeric) {
+        appendPercent(out, arg.number());
+        return;
+    }
+    if (type == PlaceholderType::Ordinal && numeric) {
+        appendOrdinal(out, arg.kind() == Kind::Integer ? arg.integer() : std::llround(arg.number()));
+        return;
+    }
+    if (type == PlaceholderType::Price && numeric) {
+        if (pattern.empty()) {
+            appendPrice(out, arg.number(), defaultConfig.currency);
+        } else {
+            appendCurrency(out, arg.number(), currencyFormatter(pattern));
+        }
+        return;
+    }
+    if (time) {
+        // A date placeholder uses its pattern; a plain one gets ISO 8601
+        const std::string_view datePattern = type == PlaceholderType::Date ? pattern : std::string_view{};
+        if (arg.kind() == Kind::Time) {
+            appendDate(out, datePattern, arg.time(), defaultConfig.date_time);
+        } else {
+            std::tm local;
+            i18n_localtime(static_cast<std::time_t>(arg.integer()), local);
+            appendDate(out, datePattern, &local, defaultConfig.date_time);
+        }
+        return;
+    }
+
+    // Plain placeholder, or a typed one whose arg has the wrong kind
+    char buf[32];
+    switch (arg.kind()) {
+        case Kind::Integer:
+            out.append(buf, std::to_chars(buf, buf + sizeof(buf), arg.integer()).ptr);
+            break;
+        case Kind::Float:
+            out.append(buf, std::to_chars(buf, buf + sizeof(buf), arg.number()).ptr);
+            break;
+        default:
+            out.append(arg.text());
+            break;
+    }
+}
+
+void I18N::trBatch(std::span<const KeyRequest> requests, BatchOutput& out) const {
+    out.clear();
+    out.slices_.resize(requests.size());
+    if (requests.empty()) {
+        return;
+    }
+
+    // Each distinct key costs one probe of the shared key index; the fallback
+    // chain is then walked with array reads on the locale columns.
+    auto resolve = [&](std::string_view key, size_t hash) -> const std::string* {
+        const size_t keyId = findKeyId(key, hash);
+        return keyId == keyIndex_.npos ? nullptr : resolveInChain(keyId);
+    };
+
+    // Hash every key once, then group requests by hash: duplicate keys become
+    // adjacent and are resolved once, and probes visit the index in hash order.
+    std::vector<std::pair<size_t, size_t>> order;
+    order.reserve(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i) {
+        order.emplace_back(keyIndex_.hashOf(requests[i].key), i);
+    }
+    std::sort(order.begin(), order.end());
+
+    // Prefetch index groups a few requests ahead so the probes overlap
+    // instead of stalling one after another.
+    constexpr size_t kPrefetchDistance = 4;
+    for (size_t i = 0; i < std::min(kPrefetchDistance, order.size()); ++i) {
+        keyIndex_.prefetch(order[i].first);
+    }
+
+    size_t totalKeyBytes = 0;
+    for (const auto& req : requests) {
+        totalKeyBytes += req.key.size();
+    }
+    out.arena_.reserve(totalKeyBytes * 2);
+
+    std::string_view prevKey;
+    const std::string* prevVal = nullptr;
+    bool havePrev = false;
+    std::optional<BatchOutput::Slice> prevPlainSlice;
+
+    for (size_t pos = 0; pos < order.size(); ++pos) {
+        if (pos + kPrefetchDistance < order.size()) {
+            keyIndex_.prefetch(order[pos + kPrefetchDistance].first);
+        }
+        const auto [hash, index] = order[pos];
+        const KeyRequest& req = requests[index];
+        BatchOutput::Slice& slice = out.slices_[index];
+        if (req.key.empty()) {
+            slice = {out.arena_.size(), 0};
+            continue;
+        }
+
+        if (!havePrev || req.key != prevKey) {
+            prevKey = req.key;
+            prevVal = resolve(req.key, hash);
+            prevPlainSlice.reset();
+            havePrev = true;
+        }
+
+        if (req.params.empty() && prevPlainSlice) {
+            // Same key without params already rendered: share its bytes
+            slice = *prevPlainSlice;
+            continue;
+        }
+
+        size_t start = out.arena_.size();
+        if (!prevVal) {
+            out.arena_.append(req.key);
+        } else {
+            interpolateArrayInto(out.arena_, *prevVal, ParamList(req.params));
+        }
+        slice = {start, out.arena_.size() - start};
+        if (req.params.empty()) {
+            prevPlainSlice = slice;
+        }
+    }
+}
+
+bool I18N::keyExists(std::string_view key) const noexcept {
+    if (locales.empty()) {
+        return false;
+    }
+
+    const size_t keyId = findKeyId(key);
+    return keyId != keyIndex_.npos && resolveInChain(keyId) != nullptr;
+}
+
+void I18N::forEachKeyWithPrefix(std::string_view prefix, const std::function<void(std::string_view)>& fn) const {
+    const size_t node = findTrieNode(prefix);
+    if (node == keyIndex_.npos) {
+        return;
+    }
+    for (size_t i = node; i < keyTrie_[node].subtreeEnd; ++i) {
+        if (keyTrie_[i].keyId != kNoEntry) {
+            fn(keyIndex_.entryAt(keyTrie_[i].keyId).key);
+        }
+    }
+}
+
+std::vector<std::pair<std::string, std::string>> I18N::trSubtree(std::string_view prefix) const {
+    std::vector<std::pair<std::string, std::string>> result;
+    const size_t node = findTrieNode(prefix);
+    if (node == keyIndex_.npos) {
+        return result;
+    }
+    for (size_t i = node; i < keyTrie_[node].subtreeEnd; ++i) {
+        const uint32_t keyId = keyTrie_[i].keyId;
+        if (keyId == kNoEntry) {
+            continue;
+        }
+        if (const std::string* val = resolveInChain(keyId)) {
+            result.emplace_back(keyIndex_.entryAt(keyId).key, interpolateArray(*val, ParamList()));
+        }
+    }
+    return result;
+}
+
+std::string_view I18N::renderBundle(std::string_view prefix, BundleFormat format) const {
+    // "a" and "a." name the same subtree
+    if (!prefix.empty() && prefix.back() == '.') {
+        prefix.remove_suffix(1);
+    }
+    const size_t node = findTrieNode(prefix);
+    if (node == keyIndex_.npos) {
+        // Unknown prefixes are not cached, so callers cannot grow the cache
+        // with arbitrary strings
+        static constexpr std::string_view kEmptyJson = "{}";
+        static constexpr std::string_view kEmptyBinary("I18B\x01\x00", 6);
+        return format == BundleFormat::Json ? kEmptyJson : kEmptyBinary;
+    }
+
+    std::string& cacheKey = cacheKeyBuf_;
+    cacheKey.assign(1, format == BundleFormat::Json ? 'J' : 'B');
+    for (const auto& link : chain_) {
+        cacheKey.append(link.locale);
+        cacheKey.push_back('\0');
+    }
+    cacheKey.push_back('\0');
+    cacheKey.append(prefix);
+
+    auto cached = bundleCache_.find(std::string_view(cacheKey));
+    if (cached != bundleCache_.end()) {
+        return cached->second;
+    }
+
+    std::string bundle;
+    size_t count = 0;
+    const size_t end = keyTrie_[node].subtreeEnd;
+
+    if (format == BundleFormat::Json) {
+        bundle.push_back('{');
+        for (size_t i = node; i < end; ++i) {
+            const uint32_t keyId = keyTrie_[i].keyId;
+            const std::string* val = keyId == kNoEntry ? nullptr : resolveInChain(keyId);
+            if (!val) {
+                continue;
+            }
+            if (count++ > 0) {
+                bundle.push_back(',');
+            }
+            appendJsonString(bundle, keyIndex_.entryAt(keyId).key);
+            bundle.push_back(':');
+            appendJsonString(bundle, *val);
+        }
+        bundle.push_back('}');
+    } else {
+        std::string entries;
+        for (size_t i = node; i < end; ++i) {
+            const uint32_t keyId = keyTrie_[i].keyId;
+            const std::string* val = keyId == kNoEntry ? nullptr : resolveInChain(keyId);
+            if (!val) {
+                continue;
+            }
+            const std::string& key = keyIndex_.entryAt(keyId).key;
+            appendVarint(entries, key.size());
+            entries.append(key);
+            appendVarint(entries, val->size());
+            entries.append(*val);
+            ++count;
+        }
+        bundle.reserve(entries.size() + 16);
+        bundle.append("I18B\x01", 5);
+        appendVarint(bundle, count);
+        bundle.append(entries);
+    }
+
+    bundle.shrink_to_fit();
+    if (bundleCache_.size() >= kBundleCacheLimit) {
+        bundleCache_.clear();
+    }
+    return bundleCache_.emplace(cacheKey, std::move(bundle)).first->second;
+}
+
+uint64_t I18N::catalogGeneration() const noexcept {
+    return catalogGeneration_;
+}
+
+std::vector<std::string> I18N::missingKeys(std::string_view locale) const {
+    // Keys with a value in any column (interned bases of "<key>.other" may have none)
+    std::vector<bool> translated(keyIndex_.size(), false);
+    for (const auto& [name, column] : localesData) {
+        for (size_t id = 0; id < column.slots.size(); ++id) {
+            if (column.slots[id] != kNoEntry) {
+                translated[id] = true;
+            }
+        }
+    }
+
+    auto localeIt = localesData.find(locale);
+    const LocaleColumn* column = localeIt == localesData.end() ? nullptr : &localeIt->second;
+
+    std::vector<std::string> result;
+    for (size_t id = 0; id < translated.size(); ++id) {
+        if (translated[id] && (!column || !column->value(static_cast<uint32_t>(id)))) {
+            result.push_back(keyIndex_.entryAt(id).key);
         }
     }
+    return result;
+}
 
-    if (params.contains("default") && params["default"].is_string()) {
-        return interpolate(params["default"].get<std::string>(), params);
+// Appends the digits of `value` with `thousandSeparator` between groups of three
+static void appendGroupedDigits(std::string& out, uint64_t value, std::string_view thousandSeparator) {
+    char digits[24];
+    const size_t digitCount = static_cast<size_t>(std::to_chars(digits, digits + sizeof(digits), value).ptr - digits);
+    for (size_t i = 0; i < digitCount; ++i) {
+        if (i > 0 && (digitCount - i) % 3 == 0) {
+            out.append(thousandSeparator);
+        }
+        out.push_back(digits[i]);
     }
-
-    return std::string(key);
 }
 
-std::string I18N::tr(std::string_view key) const {
-    return tr(key, std::span<const std::string>{});
+// Appends `fraction` as exactly `width` digits, zero-padded on the left
+static void appendFraction(std::string& out, uint64_t fraction, int width) {
+    char digits[24];
+    const size_t count = static_cast<size_t>(std::to_chars(digits, digits + sizeof(digits), fraction).ptr - digits);
+    if (count < static_cast<size_t>(width)) {
+        out.append(static_cast<size_t>(width) - count, '0');
+    }
+    out.append(digits, count);
 }
 
-std::string I18N::tr(std::string_view key, std::initializer_list<std::string> params) const {
-    return tr(key, std::span<const std::string>{params.begin(), params.size()});
+static constexpr uint64_t kPow10U64[] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+    1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+    100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+    1000000000000000000ull, 10000000000000000000ull
+};
+
+// value / divisor rounded half to even
+static uint64_t divideHalfEven(uint64_t value, uint64_t divisor) {
+    const uint64_t quotient = value / divisor;
+    const uint64_t remainder = value % divisor;
+    const uint64_t half = divisor - remainder; // compared instead of 2 * remainder, which can overflow
+    if (remainder > half || (remainder == half && (quotient & 1))) {
+        return quotient + 1;
+    }
+    return quotient;
 }
 
-std::string I18N::tr(std::string_view key, std::span<const std::string> params) const {
-    if (key.empty()) {
-        return "";
+// Appends `number` rounded to `fractDigits` with grouped thousands. Shared by
+// number and price formatting so neither builds a NumberConfig or temporaries.
+static void appendGroupedNumber(std::string& out, double number, std::string_view decimalSymbol,
+                                std::string_view thousandSeparator, int fractDigits,
+                                std::string_view positiveSymbol, std::string_view negativeSymbol) {
+    static constexpr double kPow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+    const bool isNegative = number < 0;
+    const double scale = fractDigits >= 0 && fractDigits < static_cast<int>(std::size(kPow10))
+        ? kPow10[fractDigits] : std::pow(10, fractDigits);
+    const double rounded = std::round(std::abs(number) * scale) / scale;
+
+    const long long integerPart = static_cast<long long>(rounded);
+    const double fractionalPart = rounded - integerPart;
+
+    out.append(isNegative ? negativeSymbol : positiveSymbol);
+    appendGroupedDigits(out, static_cast<uint64_t>(integerPart), thousandSeparator);
+
+    if (fractDigits > 0) {
+        out.append(decimalSymbol);
+        appendFraction(out, static_cast<uint64_t>(std::round(fractionalPart * scale)), fractDigits);
     }
+}
 
-    // Build cache key: key \0 param1 \0 param2 ...
-    std::string cacheKey;
-    cacheKey.reserve(key.size() + params.size() * 8);
-    cacheKey.append(key);
-    for (const auto& p : params) {
-        cacheKey.push_back('\0');
-        cacheKey.append(p);
-    }
+// Appends `value` as exactly two digits
+static void appendTwoDigits(std::string& out, int value) {
+    out.push_back(static_cast<char>('0' + value / 10));
+    out.push_back(static_cast<char>('0' + value % 10));
+}
 
-    auto cacheIt = translationCache_.find(cacheKey);
-    if (cacheIt != translationCache_.end()) {
-        return cacheIt->second;
-    }
+std::string I18N::formatNumberWithConfig(double number, const NumberConfig& config) const {
+    std::string result;
+    appendNumber(result, number, config);
+    return result;
+}
 
-    std::vector<std::string> fallbacks = getFallbacks(locales);
-    std::string compositeKey;
-    compositeKey.reserve(key.size() + 8);
+void I18N::appendNumber(std::string& out, double number, const NumberConfig& config) const {
+    appendGroupedNumber(out, number, config.decimal_symbol, config.thousand_separator,
+                        config.fract_digits, config.positive_symbol, config.negative_symbol);
+}
 
-    for (const auto& loc : fallbacks) {
-        const std::string* val = getTranslationData(key, loc);
-        if (val) {
-            std::string result = interpolateArray(*val, params);
-            translationCache_[std::move(cacheKey)] = result;
-            return result;
-        }
-        // Fallback: try key.other (for plural keys called without count)
-        compositeKey.assign(key);
-        compositeKey.append(".other");
-        val = getTranslationData(compositeKey, loc);
-        if (val) {
-            std::string result = interpolateArray(*val, params);
-            translationCache_[std::move(cacheKey)] = result;
-            return result;
+void I18N::appendCompact(std::string& out, int64_t value) const {
+    const CompactConfig& compact = defaultConfig.compact;
+    const NumberConfig& number = defaultConfig.number;
+    const uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    const int fractDigits = std::clamp(compact.fract_digits, 0, 3);
+
+    // Highest magnitude 10^(3 * level) not above the value (level 0 is none)
+    const size_t maxLevel = std::min<size_t>(compact.suffixes.size(), 6);
+    size_t level = 0;
+    while (level < maxLevel && magnitude >= kPow10U64[3 * (level + 1)]) {
+        ++level;
+    }
+    if (level > 0 && compact.suffixes[level - 1].empty()) {
+        level = 0;
+    }
+
+    // Scaled to fractDigits, in units of 10^(3 * level - fractDigits)
+    uint64_t scaled = magnitude;
+    int digits = 0;
+    if (level > 0) {
+        digits = fractDigits;
+        scaled = divideHalfEven(magnitude, kPow10U64[3 * level - digits]);
+        if (scaled >= 1000 * kPow10U64[digits] && level < maxLevel && !compact.suffixes[level].empty()) {
+            ++level;
+            scaled = divideHalfEven(magnitude, kPow10U64[3 * level - digits]);
         }
     }
+    uint64_t integerPart = scaled / kPow10U64[digits];
+    uint64_t fraction = scaled % kPow10U64[digits];
+    while (digits > 0 && fraction % 10 == 0) {
+        fraction /= 10;
+        --digits;
+    }
 
-    return std::string(key);
+    out.append(value < 0 ? number.negative_symbol : number.positive_symbol);
+    appendGroupedDigits(out, integerPart, number.thousand_separator);
+    if (digits > 0) {
+        out.append(number.decimal_symbol);
+        appendFraction(out, fraction, digits);
+    }
+    if (level > 0) {
+        out.append(compact.suffixes[level - 1]);
+    }
 }
 
-std::string I18N::trPlural(std::string_view key, int count) const {
-    return trPlural(key, count, std::span<const std::string>{});
+void I18N::appendPercent(std::string& out, double ratio) const {
+    const PercentConfig& percent = defaultConfig.percent;
+    const NumberConfig& number = defaultConfig.number;
+    const int fractDigits = std::clamp(percent.fract_digits, 0, 9);
+
+    // nearbyint() rounds half to even in the default rounding mode; the
+    // clamp keeps huge or non-finite ratios inside uint64_t
+    double scaled = std::abs(ratio) * 100.0 * static_cast<double>(kPow10U64[fractDigits]);
+    if (!(scaled < 1.8e19)) {
+        scaled = std::isnan(scaled) ? 0.0 : 1.8e19;
+    }
+    const uint64_t rounded = static_cast<uint64_t>(std::nearbyint(scaled));
+
+    out.append(ratio < 0 && rounded != 0 ? number.negative_symbol : number.positive_symbol);
+    out.append(percent.prefix);
+    appendGroupedDigits(out, rounded / kPow10U64[fractDigits], number.thousand_separator);
+    if (fractDigits > 0) {
+        out.append(number.decimal_symbol);
+        appendFraction(out, rounded % kPow10U64[fractDigits], fractDigits);
+    }
+    out.append(percent.suffix);
 }
 
-std::string I18N::trPlural(std::string_view key, int count, std::initializer_list<std::string> params) const {
-    return trPlural(key, count, std::span<const std::string>{params.begin(), params.size()});
+// Counts past int range keep their last six digits for the plural rules
+static int pluralCount(uint64_t count) {
+    return count <= static_cast<uint64_t>(std::numeric_limits<int>::max())
+        ? static_cast<int>(count) : static_cast<int>(count % 1000000 + 1000000);
 }
 
-std::string I18N::trPlural(std::string_view key, int count, std::span<const std::string> params) const {
-    if (key.empty()) {
-        return "";
+void I18N::splitTemplate(const std::string& text, std::vector<std::string>& literals, std::vector<int32_t>& args) {
+    const CompiledTemplate compiled = compileTemplate(text, Escape::None);
+    literals.assign(1, std::string());
+    args.clear();
+    for (const TemplatePart& part : compiled.parts) {
+        if (part.argIndex < 0) {
+            literals.back().append(text, part.offset, part.length);
+        } else {
+            args.push_back(part.argIndex);
+            literals.emplace_back();
+        }
     }
+}
 
-    // Build cache key: key \0P\0 count \0 param1 \0 param2 ...
-    std::string countStr = std::to_string(count);
-    std::string cacheKey;
-    cacheKey.reserve(key.size() + countStr.size() + params.size() * 8 + 4);
-    cacheKey.append(key);
-    cacheKey.append("\0P\0", 3);
-    cacheKey.append(countStr);
-    for (const auto& p : params) {
-        cacheKey.push_back('\0');
-        cacheKey.append(p);
+bool I18N::compileListPattern(const std::string& text, ListPattern& pattern) {
+    std::vector<std::string> literals;
+    std::vector<int32_t> args;
+    splitTemplate(text, literals, args);
+    if (args.size() != 2 || args[0] != 0 || args[1] != 1) {
+        return false;
     }
+    pattern.before = std::move(literals[0]);
+    pattern.between = std::move(literals[1]);
+    pattern.after = std::move(literals[2]);
+    return true;
+}
 
-    auto cacheIt = translationCache_.find(cacheKey);
-    if (cacheIt != translationCache_.end()) {
-        return cacheIt->second;
+void I18N::compileCountForms(const std::map<std::string, std::string, std::less<>>& templates, CountForms& forms) {
+    std::vector<std::string> literals;
+    std::vector<int32_t> args;
+    const auto otherIt = templates.find("other");
+    for (size_t category = 0; category < kPluralCategories.size(); ++category) {
+        auto it = templates.find(kPluralCategories[category]);
+        if (it == templates.end()) {
+            it = otherIt;
+        }
+        if (it == templates.end()) {
+            continue;
+        }
+        // The first placeholder takes the count; any others are dropped
+        splitTemplate(it->second, literals, args);
+        CountPiece& piece = forms[category];
+        piece.prefix = std::move(literals[0]);
+        piece.suffix.clear();
+        for (size_t i = 1; i < literals.size(); ++i) {
+            piece.suffix.append(literals[i]);
+        }
+        piece.hasCount = !args.empty();
     }
+}
 
-    std::vector<std::string> fallbacks = getFallbacks(locales);
+static constexpr std::string_view kRelativeUnitNames[] = {"second", "minute", "hour", "day", "week", "month", "year"};
+// Months and years are Gregorian averages (30.436875 and 365.2425 days)
+static constexpr uint64_t kRelativeUnitSeconds[] = {1, 60, 3600, 86400, 604800, 2629746, 31556952};
 
-    // Build extended params with count as first element (reuse member buffer)
-    extendedParamsBuf_.clear();
-    extendedParamsBuf_.reserve(params.size() + 1);
-    extendedParamsBuf_.push_back(countStr);
-    extendedParamsBuf_.insert(extendedParamsBuf_.end(), params.begin(), params.end());
-    const auto& extendedParams = extendedParamsBuf_;
+// Largest unit not above `magnitude` seconds
+static size_t relativeUnit(uint64_t magnitude) {
+    size_t unit = std::size(kRelativeUnitSeconds) - 1;
+    while (unit > 0 && magnitude < kRelativeUnitSeconds[unit]) {
+        --unit;
+    }
+    return unit;
+}
 
-    std::string compositeKey;
-    compositeKey.reserve(key.size() + 12);
+const I18N::RelativeFormatter& I18N::relativeFormatter() const {
+    if (relativeFormatter_) {
+        return *relativeFormatter_;
+    }
+    RelativeFormatter& formatter = relativeFormatter_.emplace();
+    const RelativeTimeConfig& config = defaultConfig.relative;
+    formatter.now = config.now;
+    formatter.pluralRule = locales.empty() ? 1 : pluralRuleFor(locales[0]);
+
+    for (size_t future = 0; future < 2; ++future) {
+        const auto& units = future ? config.future : config.past;
+        for (size_t unit = 0; unit < kRelativeUnits; ++unit) {
+            const auto it = units.find(kRelativeUnitNames[unit]);
+            if (it != units.end()) {
+                compileCountForms(it->second, formatter.forms[future][unit]);
+            }
+        }
+    }
+    return formatter;
+}
 
-    for (const auto& loc : fallbacks) {
-        std::string pluralForm = getPluralForm(loc, count);
+void I18N::appendRelative(std::string& out, const RelativeFormatter& formatter, bool future, size_t unit,
+                          uint64_t count) {
+    const CountPiece& piece = formatter.forms[future][unit][pluralCategory(formatter.pluralRule, pluralCount(count))];
+    char digits[24];
+    const size_t digitCount = piece.hasCount
+        ? static_cast<size_t>(std::to_chars(digits, digits + sizeof(digits), count).ptr - digits) : 0;
+    out.reserve(out.size() + piece.prefix.size() + digitCount + piece.suffix.size());
+    out.append(piece.prefix);
+    out.append(digits, digitCount);
+    out.append(piece.suffix);
+}
 
-        // Try plural form: key.one, key.other, key.few, etc.
-        compositeKey.assign(key);
-        compositeKey.push_back('.');
-        compositeKey.append(pluralForm);
-        const std::string* val = getTranslationData(compositeKey, loc);
-        if (val) {
-            std::string result = interpolateArray(*val, extendedParams);
-            translationCache_[std::move(cacheKey)] = result;
-            return result;
-        }
+std::string I18N::formatRelative(std::chrono::seconds delta) const {
+    const RelativeFormatter& formatter = relativeFormatter();
+    const int64_t seconds = delta.count();
+    if (seconds == 0) {
+        return formatter.now;
+    }
+    const uint64_t magnitude = seconds < 0 ? 0 - static_cast<uint64_t>(seconds) : static_cast<uint64_t>(seconds);
+    const size_t unit = relativeUnit(magnitude);
+    std::string result;
+    appendRelative(result, formatter, seconds > 0, unit, magnitude / kRelativeUnitSeconds[unit]);
+    return result;
+}
 
-        // Fallback to "other"
-        compositeKey.assign(key);
-        compositeKey.append(".other");
-        val = getTranslationData(compositeKey, loc);
-        if (val) {
-            std::string result = interpolateArray(*val, extendedParams);
-            translationCache_[std::move(cacheKey)] = result;
-            return result;
+void I18N::formatRelativeBatch(std::span<const std::chrono::seconds> deltas, BatchOutput& out) const {
+    out.clear();
+    out.slices_.resize(deltas.size());
+    const RelativeFormatter& formatter = relativeFormatter();
+
+    // Bounds [low, high) of the current unit, and the last rendered result
+    uint64_t low = 1;
+    uint64_t high = 0;
+    size_t unit = 0;
+    int lastSign = 2;
+    size_t lastUnit = 0;
+    uint64_t lastCount = 0;
+    BatchOutput::Slice lastSlice;
+
+    for (size_t i = 0; i < deltas.size(); ++i) {
+        const int64_t seconds = deltas[i].count();
+        const int sign = (seconds > 0) - (seconds < 0);
+        uint64_t count = 0;
+        if (sign != 0) {
+            const uint64_t magnitude = seconds < 0 ? 0 - static_cast<uint64_t>(seconds) : static_cast<uint64_t>(seconds);
+            if (magnitude < low || magnitude >= high) {
+                unit = relativeUnit(magnitude);
+                low = kRelativeUnitSeconds[unit];
+                high = unit + 1 < kRelativeUnits ? kRelativeUnitSeconds[unit + 1] : std::numeric_limits<uint64_t>::max();
+            }
+            count = magnitude / kRelativeUnitSeconds[unit];
         }
-
-        // Fallback to exact count
-        compositeKey.assign(key);
-        compositeKey.push_back('.');
-        compositeKey.append(extendedParams[0]); // count string already built
-        val = getTranslationData(compositeKey, loc);
-        if (val) {
-            std::string result = interpolateArray(*val, extendedParams);
-            translationCache_[std::move(cacheKey)] = result;
-            return result;
+        if (sign == lastSign && (sign == 0 || (unit == lastUnit && count == lastCount))) {
+            out.slices_[i] = lastSlice;
+            continue;
         }
 
-        // Fallback: direct key (if it's a plain string with placeholders)
-        val = getTranslationData(key, loc);
-        if (val) {
-            std::string result = interpolateArray(*val, extendedParams);
-            translationCache_[std::move(cacheKey)] = result;
-            return result;
+        const size_t start = out.arena_.size();
+        if (sign == 0) {
+            out.arena_.append(formatter.now);
+        } else {
+            appendRelative(out.arena_, formatter, sign > 0, unit, count);
         }
+        lastSlice = {start, out.arena_.size() - start};
+        lastSign = sign;
+        lastUnit = unit;
+        lastCount = count;
+        out.slices_[i] = lastSlice;
     }
+}
 
-    return std::string(key);
+static constexpr std::string_view kDurationUnitNames[] = {"day", "hour", "minute", "second"};
+static constexpr uint64_t kDurationUnitSeconds[] = {86400, 3600, 60, 1};
+
+const I18N::ListFormatter& I18N::listFormatter() const {
+    if (listFormatter_) {
+        return *listFormatter_;
+    }
+    // configure() has validated the patterns
+    ListFormatter& formatter = listFormatter_.emplace();
+    const ListConfig& config = defaultConfig.list;
+    compileListPattern(config.pair, formatter.pair);
+    compileListPattern(config.start, formatter.start);
+    compileListPattern(config.middle, formatter.middle);
+    compileListPattern(config.end, formatter.end);
+    return formatter;
 }
 
-bool I18N::keyExists(std::string_view key) const noexcept {
-    if (locales.empty()) {
-        return false;
+const I18N::DurationFormatter& I18N::durationFormatter() const {
+    if (durationFormatter_) {
+        return *durationFormatter_;
     }
-    
-    try {
-        std::vector<std::string> fallbacks = getFallbacks(locales);
-        
-        std::string otherKey;
-        otherKey.reserve(key.size() + 6);
-        otherKey.assign(key);
-        otherKey.append(".other");
-
-        for (const auto& loc : fallbacks) {
-            if (getTranslationData(key, loc) != nullptr) {
-                return true;
-            }
-            if (getTranslationData(otherKey, loc) != nullptr) {
-                return true;
-            }
+    DurationFormatter& formatter = durationFormatter_.emplace();
+    const DurationConfig& config = defaultConfig.duration;
+    for (size_t unit = 0; unit < kDurationUnits; ++unit) {
+        // A category with neither its own template nor "other" shows the
+        // bare count rather than an empty component
+        for (CountPiece& piece : formatter.forms[unit]) {
+            piece.hasCount = true;
+        }
+        const auto it = config.units.find(kDurationUnitNames[unit]);
+        if (it != config.units.end()) {
+            compileCountForms(it->second, formatter.forms[unit]);
         }
-    } catch (...) {
-        return false;
     }
-    
-    return false;
+    formatter.separator = config.separator;
+    if (config.max_units > 0) {
+        formatter.maxUnits = std::min(static_cast<size_t>(config.max_units), kDurationUnits);
+    }
+    formatter.pluralRule = locales.empty() ? 1 : pluralRuleFor(locales[0]);
+    return formatter;
 }
 
-std::string I18N::separateThousand(std::string_view amount, std::string_view separator) const {
-    std::string result(amount);
-    
-    size_t decimalPos = result.find('.');
-    std::string integerPart = (decimalPos != std::string::npos) ? result.substr(0, decimalPos) : result;
-    std::string fractionalPart = (decimalPos != std::string::npos) ? result.substr(decimalPos) : "";
-    
-    bool isNegative = !integerPart.empty() && integerPart[0] == '-';
-    
-    if (isNegative) {
-        integerPart = integerPart.substr(1);
+std::string I18N::formatList(std::span<const std::string_view> items) const {
+    std::string result;
+    formatListInto(result, items);
+    return result;
+}
+
+void I18N::formatListInto(std::string& out, std::span<const std::string_view> items) const {
+    const size_t n = items.size();
+    if (n == 0) {
+        return;
     }
-    
-    int insertPos = static_cast<int>(integerPart.length()) - 3;
-    while (insertPos > 0) {
-        integerPart.insert(insertPos, separator);
-        insertPos -= 3;
+    if (n == 1) {
+        out.append(items[0]);
+        return;
     }
-    
-    result = (isNegative ? "-" : "") + integerPart + fractionalPart;
-    
-    return result;
+    const ListFormatter& formatter = listFormatter();
+    const auto patternSize = [](const ListPattern& pattern) {
+        return pattern.before.size() + pattern.between.size() + pattern.after.size();
+    };
+
+    // Exact size first: every item, plus each pattern level's literals
+    size_t size = 0;
+    for (std::string_view item : items) {
+        size += item.size();
+    }
+    if (n == 2) {
+        size += patternSize(formatter.pair);
+    } else {
+        size += patternSize(formatter.start) + patternSize(formatter.end) + (n - 3) * patternSize(formatter.middle);
+    }
+    out.reserve(out.size() + size);
+
+    if (n == 2) {
+        const ListPattern& pair = formatter.pair;
+        out.append(pair.before).append(items[0]).append(pair.between).append(items[1]).append(pair.after);
+        return;
+    }
+    // start(a, middle(b, ... end(y, z))): opening literals in order, then
+    // the `after` literals of the enclosing levels innermost first
+    out.append(formatter.start.before).append(items[0]).append(formatter.start.between);
+    for (size_t i = 1; i + 2 < n; ++i) {
+        out.append(formatter.middle.before).append(items[i]).append(formatter.middle.between);
+    }
+    const ListPattern& end = formatter.end;
+    out.append(end.before).append(items[n - 2]).append(end.between).append(items[n - 1]).append(end.after);
+    for (size_t i = 1; i + 2 < n; ++i) {
+        out.append(formatter.middle.after);
+    }
+    out.append(formatter.start.after);
 }
 
-std::string I18N::formatNumberWithConfig(double number, const NumberConfig& config) const {
+std::string I18N::formatDuration(std::chrono::seconds duration) const {
     std::string result;
-    result.reserve(30); // Reserve memory for optimization
-    
-    bool isNegative = number < 0;
-    double absNumber = std::abs(number);
-    
-    double rounded = std::round(absNumber * std::pow(10, config.fract_digits)) / std::pow(10, config.fract_digits);
-    
-    long long integerPart = static_cast<long long>(rounded);
-    double fractionalPart = rounded - integerPart;
-    
-    std::string integerStr = std::to_string(integerPart);
-    integerStr = separateThousand(integerStr, config.thousand_separator);
-    
-    result.append(integerStr);
-    
-    if (config.fract_digits > 0) {
-        result.append(config.decimal_symbol);
-        
-        long long scaledFract = static_cast<long long>(std::round(fractionalPart * std::pow(10, config.fract_digits)));
-        std::string fractionalStr = std::to_string(scaledFract);
-        
+    formatDurationInto(result, duration);
+    return result;
+}
 
-        if (fractionalStr.length() < static_cast<size_t>(config.fract_digits)) {
-            result.append(config.fract_digits - fractionalStr.length(), '0');
+void I18N::formatDurationInto(std::string& out, std::chrono::seconds duration) const {
+    const DurationFormatter& formatter = durationFormatter();
+    const int64_t seconds = duration.count();
+    uint64_t remaining = seconds < 0 ? 0 - static_cast<uint64_t>(seconds) : static_cast<uint64_t>(seconds);
+
+    // Pick the units and their pieces, format the counts, then size exactly
+    struct Component {
+        const CountPiece* piece;
+        char digits[24];
+        size_t digitCount;
+    };
+    Component components[kDurationUnits];
+    size_t componentCount = 0;
+    for (size_t unit = 0; unit < kDurationUnits && componentCount < formatter.maxUnits; ++unit) {
+        const uint64_t count = remaining / kDurationUnitSeconds[unit];
+        remaining %= kDurationUnitSeconds[unit];
+        const bool last = unit + 1 == kDurationUnits && componentCount == 0;
+        if (count == 0 && !last) {
+            continue;
         }
-        
-        result.append(fractionalStr);
+        Component& component = components[componentCount++];
+        component.piece = &formatter.forms[unit][pluralCategory(formatter.pluralRule, pluralCount(count))];
+        component.digitCount = component.piece->hasCount
+            ? static_cast<size_t>(std::to_chars(component.digits, component.digits + sizeof(component.digits), count).ptr - component.digits)
+            : 0;
     }
-    
-    if (isNegative) {
-        return config.negative_symbol + result;
-    } else if (!config.positive_symbol.empty()) {
-        return config.positive_symbol + result;
+
+    const std::string_view sign = seconds < 0 ? std::string_view(defaultConfig.number.negative_symbol) : std::string_view{};
+    size_t size = sign.size() + (componentCount - 1) * formatter.separator.size();
+    for (size_t i = 0; i < componentCount; ++i) {
+        size += components[i].piece->prefix.size() + components[i].digitCount + components[i].piece->suffix.size();
     }
-    
+    out.reserve(out.size() + size);
+
+    out.append(sign);
+    for (size_t i = 0; i < componentCount; ++i) {
+        if (i > 0) {
+            out.append(formatter.separator);
+        }
+        out.append(components[i].piece->prefix);
+        out.append(components[i].digits, components[i].digitCount);
+        out.append(components[i].piece->suffix);
+    }
+}
+
+const I18N::OrdinalFormatter& I18N::ordinalFormatter() const {
+    if (ordinalFormatter_) {
+        return *ordinalFormatter_;
+    }
+    OrdinalFormatter& formatter = ordinalFormatter_.emplace();
+    formatter.ordinalRule = locales.empty() ? 1 : ordinalRuleFor(locales[0]);
+    if (!defaultConfig.ordinal.forms.empty()) {
+        compileCountForms(defaultConfig.ordinal.forms, formatter.forms);
+        return formatter;
+    }
+    // Unconfigured: English suffixes only fit English ordinal categories
+    // (rule 1); "2th" is wrong anywhere else, so other rules get the number
+    static const std::map<std::string, std::string, std::less<>> kEnglishForms = {
+        {"one", "{0}st"}, {"two", "{0}nd"}, {"few", "{0}rd"}, {"other", "{0}th"}
+    };
+    static const std::map<std::string, std::string, std::less<>> kPlainForms = {{"other", "{0}"}};
+    compileCountForms(formatter.ordinalRule == 1 ? kEnglishForms : kPlainForms, formatter.forms);
+    return formatter;
+}
+
+std::string I18N::formatOrdinal(int64_t n) const {
+    std::string result;
+    appendOrdinal(result, n);
     return result;
 }
 
+void I18N::formatOrdinalInto(std::string& out, int64_t n) const {
+    appendOrdinal(out, n);
+}
+
+void I18N::appendOrdinal(std::string& out, int64_t n) const {
+    const OrdinalFormatter& formatter = ordinalFormatter();
+    const uint64_t magnitude = n < 0 ? 0 - static_cast<uint64_t>(n) : static_cast<uint64_t>(n);
+    const CountPiece& piece = formatter.forms[ordinalCategory(formatter.ordinalRule, pluralCount(magnitude))];
+    const std::string_view sign = n < 0 ? std::string_view(defaultConfig.number.negative_symbol) : std::string_view{};
+    char digits[24];
+    const size_t digitCount = piece.hasCount
+        ? static_cast<size_t>(std::to_chars(digits, digits + sizeof(digits), magnitude).ptr - digits) : 0;
+    out.reserve(out.size() + piece.prefix.size() + sign.size() + digitCount + piece.suffix.size());
+    out.append(piece.prefix);
+    out.append(sign);
+    out.append(digits, digitCount);
+    out.append(piece.suffix);
+}
+
 std::string I18N::formatPriceWithConfig(double amount, const CurrencyConfig& config) const {
-    std::string formattedNumber = formatNumberWithConfig(amount, 
-        NumberConfig{
-            config.decimal_symbol,
-            config.thousand_separator,
-            config.fract_digits,
-            config.positive_symbol,
-            config.negative_symbol
-        }
-    );
-    
-    std::string pattern = amount < 0 ? config.negative_format : config.positive_format;
-    
     std::string result;
-    result.reserve(pattern.size() + formattedNumber.size() + config.symbol.size());
-    
+    appendPrice(result, amount, config);
+    return result;
+}
+
+void I18N::appendPrice(std::string& out, double amount, const CurrencyConfig& config) const {
+    const std::string_view pattern = amount < 0 ? config.negative_format : config.positive_format;
+
     size_t pos = 0;
     size_t foundPos;
-    
+
     while (pos < pattern.size()) {
         foundPos = pattern.find('%', pos);
-        if (foundPos == std::string::npos) {
-            result.append(pattern, pos, std::string::npos);
+        if (foundPos == std::string_view::npos) {
+            out.append(pattern, pos, std::string_view::npos);
             break;
         }
-        
-        result.append(pattern, pos, foundPos - pos);
-        
+
+        out.append(pattern, pos, foundPos - pos);
+
         if (foundPos + 1 < pattern.size()) {
             char formatChar = pattern[foundPos + 1];
             switch (formatChar) {
-                case 'p': // %p - Empty string as sign is already included in formattedNumber
+                case 'p': // %p - Empty string as sign is already included in the number
                     break;
                 case 'q': // %q - Formatted number
-                    result.append(formattedNumber);
+                    appendGroupedNumber(out, amount, config.decimal_symbol, config.thousand_separator,
+                                        config.fract_digits, config.positive_symbol, config.negative_symbol);
                     break;
                 case 'c': // %c - Currency symbol
-                    result.append(config.symbol);
+                    out.append(config.symbol);
                     break;
                 default: // Unknown format - keep as is
-                    result.push_back('%');
-                    result.push_back(formatChar);
+                    out.push_back('%');
+                    out.push_back(formatChar);
                     break;
             }
             pos = foundPos + 2; // Skip % and format character
         } else {
             // % at the end of the string
-            result.push_back('%');
+            out.push_back('%');
             pos = foundPos + 1;
         }
     }
-    
-    return result;
+}
+
+I18N::CurrencyFormatter I18N::compileCurrency(const CurrencyConfig& config) {
+    CurrencyFormatter formatter;
+    formatter.decimalSymbol = config.decimal_symbol;
+    formatter.thousandSeparator = config.thousand_separator;
+    formatter.positiveSymbol = config.positive_symbol;
+    formatter.negativeSymbol = config.negative_symbol;
+    formatter.fractDigits = config.fract_digits;
+
+    // Same substitutions as appendPrice(), done once
+    const auto split = [&](std::string_view pattern, std::vector<std::string>& literals) {
+        literals.emplace_back();
+        size_t pos = 0;
+        while (pos < pattern.size()) {
+            const size_t foundPos = pattern.find('%', pos);
+            if (foundPos == std::string_view::npos || foundPos + 1 == pattern.size()) {
+                literals.back().append(pattern, pos, std::string_view::npos);
+                break;
+            }
+            literals.back().append(pattern, pos, foundPos - pos);
+            switch (pattern[foundPos + 1]) {
+                case 'p':
+                    break;
+                case 'q':
+                    literals.emplace_back();
+                    break;
+                case 'c':
+                    literals.back().append(config.symbol);
+                    break;
+                default:
+                    literals.back().append(pattern, foundPos, 2);
+                    break;
+            }
+            pos = foundPos + 2;
+        }
+    };
+    split(config.positive_format, formatter.positive);
+    split(config.negative_format, formatter.negative);
+    return formatter;
+}
+
+void I18N::appendCurrency(std::string& out, double amount, const CurrencyFormatter& formatter) {
+    const std::vector<std::string>& literals = amount < 0 ? formatter.negative : formatter.positive;
+    out.append(literals[0]);
+    for (size_t i = 1; i < literals.size(); ++i) {
+        appendGroupedNumber(out, amount, formatter.decimalSymbol, formatter.thousandSeparator,
+                            formatter.fractDigits, formatter.positiveSymbol, formatter.negativeSymbol);
+        out.append(literals[i]);
+    }
+}
+
+const I18N::CurrencyFormatter& I18N::currencyFormatter(std::string_view currency) const {
+    if (const CurrencyFormatter* formatter = currencyFormatters_.find(currency)) {
+        return *formatter;
+    }
+    // Codes come from callers, so bound the table like the other caches
+    if (currencyFormatters_.size() >= kCurrencyFormatterLimit) {
+        currencyFormatters_.clear();
+    }
+
+    CurrencyFormatter formatter;
+    const auto it = defaultConfig.currencies.find(currency);
+    if (it != defaultConfig.currencies.end()) {
+        formatter = compileCurrency(it->second);
+    } else if (currency == defaultConfig.currency.short_name) {
+        formatter = compileCurrency(defaultConfig.currency);
+    } else {
+        CurrencyConfig config = defaultConfig.currency;
+        config.symbol = currency;
+        formatter = compileCurrency(config);
+    }
+    return currencyFormatters_[currency] = std::move(formatter);
 }
 
 std::string I18N::formatDateWithConfig(std::string_view pattern, const std::tm* date, const DateTimeConfig& config) const {
+    std::string result;
+    appendDate(result, pattern, date, config);
+    return result;
+}
+
+void I18N::appendDate(std::string& out, std::string_view pattern, const std::tm* date, const DateTimeConfig& config) const {
     std::tm timeinfo;
     if (date) {
         timeinfo = *date;
@@ -994,10 +3136,10 @@ std::string I18N::formatDateWithConfig(std::string_view pattern, const std::tm*
         std::time_t now = std::time(nullptr);
         i18n_localtime(now, timeinfo);
     }
-    
+
     // Determine format pattern
-    std::string formatPattern;
-    
+    std::string_view formatPattern;
+
     // If pattern is empty, use ISO 8601
     if (pattern.empty()) {
         formatPattern = "%Y-%m-%dT%H:%M:%S";
@@ -1014,110 +3156,106 @@ std::string I18N::formatDateWithConfig(std::string_view pattern, const std::tm*
     } else if (pattern == "short_date_time") {
         formatPattern = config.short_date_time;
     } else {
-        formatPattern = std::string(pattern);
+        formatPattern = pattern;
     }
-    
-    std::string result;
-    result.reserve(formatPattern.size() * 2);
 
     size_t pos = 0;
     size_t foundPos;
-    
+
     while (pos < formatPattern.size()) {
         foundPos = formatPattern.find('%', pos);
-        if (foundPos == std::string::npos) {
+        if (foundPos == std::string_view::npos) {
             // Add remaining part of the pattern
-            result.append(formatPattern, pos, std::string::npos);
+            out.append(formatPattern, pos, std::string_view::npos);
             break;
         }
-        
+
         // Add text before %
-        result.append(formatPattern, pos, foundPos - pos);
-        
+        out.append(formatPattern, pos, foundPos - pos);
+
         // Skip % and check next character
         if (foundPos + 1 < formatPattern.size()) {
             char formatChar = formatPattern[foundPos + 1];
-            
+
             // Format according to specifier
             switch (formatChar) {
                 case 'H': // %H - Hour (00-23)
-                    result.append(std::to_string(timeinfo.tm_hour / 10)).append(std::to_string(timeinfo.tm_hour % 10));
+                    appendTwoDigits(out, timeinfo.tm_hour);
                     break;
                 case 'M': // %M - Minute (00-59)
                 case 'i': // %i - Alias for minute
-                    result.append(std::to_string(timeinfo.tm_min / 10)).append(std::to_string(timeinfo.tm_min % 10));
+                    appendTwoDigits(out, timeinfo.tm_min);
                     break;
                 case 'S': // %S - Second (00-59)
                 case 's': // %s - Alias for second
-                    result.append(std::to_string(timeinfo.tm_sec / 10)).append(std::to_string(timeinfo.tm_sec % 10));
+                    appendTwoDigits(out, timeinfo.tm_sec);
                     break;
                 case 'd': // %d - Day of the month (01-31)
-                    result.append(std::to_string(timeinfo.tm_mday / 10)).append(std::to_string(timeinfo.tm_mday % 10));
+                    appendTwoDigits(out, timeinfo.tm_mday);
                     break;
                 case 'm': // %m - Month (01-12)
-                    result.append(std::to_string((timeinfo.tm_mon + 1) / 10)).append(std::to_string((timeinfo.tm_mon + 1) % 10));
+                    appendTwoDigits(out, timeinfo.tm_mon + 1);
                     break;
-                case 'Y': // %Y - Year (4 digits)
-                    result.append(std::to_string(timeinfo.tm_year + 1900));
+                case 'Y': { // %Y - Year (4 digits)
+                    char buf[12];
+                    out.append(buf, std::to_chars(buf, buf + sizeof(buf), timeinfo.tm_year + 1900).ptr);
                     break;
+                }
                 case 'l': // %l - Full name of the day of the week
                     if (timeinfo.tm_wday >= 0 && timeinfo.tm_wday < static_cast<int>(defaultConfig.long_day_names.size())) {
-                        result.append(defaultConfig.long_day_names[timeinfo.tm_wday]);
+                        out.append(defaultConfig.long_day_names[timeinfo.tm_wday]);
                     }
                     break;
                 case 'F': // %F - Full name of the month
                     if (timeinfo.tm_mon >= 0 && timeinfo.tm_mon < static_cast<int>(defaultConfig.long_month_names.size())) {
-                        result.append(defaultConfig.long_month_names[timeinfo.tm_mon]);
+                        out.append(defaultConfig.long_month_names[timeinfo.tm_mon]);
                     }
                     break;
                 case 'a': // %a - Abbreviated name of the day of the week
                     if (timeinfo.tm_wday >= 0 && timeinfo.tm_wday < static_cast<int>(defaultConfig.short_day_names.size())) {
-                        result.append(defaultConfig.short_day_names[timeinfo.tm_wday]);
+                        out.append(defaultConfig.short_day_names[timeinfo.tm_wday]);
                     }
                     break;
                 case 'B': // %B - Full name of the month (standard strftime alias)
                     if (timeinfo.tm_mon >= 0 && timeinfo.tm_mon < static_cast<int>(defaultConfig.long_month_names.size())) {
-                        result.append(defaultConfig.long_month_names[timeinfo.tm_mon]);
+                        out.append(defaultConfig.long_month_names[timeinfo.tm_mon]);
                     }
                     break;
                 case 'b': // %b - Abbreviated name of the month
                     if (timeinfo.tm_mon >= 0 && timeinfo.tm_mon < static_cast<int>(defaultConfig.short_month_names.size())) {
-                        result.append(defaultConfig.short_month_names[timeinfo.tm_mon]);
+                        out.append(defaultConfig.short_month_names[timeinfo.tm_mon]);
                     }
                     break;
                 case 'I': { // %I - Hour (01-12)
                     int hour12 = (timeinfo.tm_hour % 12);
                     if (hour12 == 0) hour12 = 12;
-                    char buf[3];
-                    snprintf(buf, sizeof(buf), "%02d", hour12);
-                    result.append(buf);
+                    appendTwoDigits(out, hour12);
                     break;
                 }
                 case 'p': // %p - AM/PM marker
-                    result.append(timeinfo.tm_hour < 12 ? "AM" : "PM");
+                    out.append(timeinfo.tm_hour < 12 ? "AM" : "PM");
                     break;
                 default: // Unknown format - keep as is
-                    result.push_back('%');
-                    result.push_back(formatChar);
+                    out.push_back('%');
+                    out.push_back(formatChar);
                     break;
             }
-            
+
             pos = foundPos + 2; // Skip % and format character
         } else {
             // % at the end of the string
-            result.push_back('%');
+            out.push_back('%');
             pos = foundPos + 1;
         }
     }
-    
-    return result;
 }
 
 std::string I18N::formatNumber(double number) const {
-    std::string cacheKey = i18n_fmt::format("n:{}", number);
-    auto it = formatCache_.find(cacheKey);
-    if (it != formatCache_.end()) {
-        return it->second;
+    std::string& cacheKey = cacheKeyBuf_;
+    cacheKey.clear();
+    i18n_fmt::format_to(std::back_inserter(cacheKey), "n:{}", number);
+    if (const std::string* cached = formatCache_.find(cacheKey)) {
+        return *cached;
     }
     std::string result = formatNumberWithConfig(number, defaultConfig.number);
     formatCache_[cacheKey] = result;
@@ -1125,25 +3263,45 @@ std::string I18N::formatNumber(double number) const {
 }
 
 std::string I18N::formatPrice(double amount) const {
-    std::string cacheKey = i18n_fmt::format("p:{}", amount);
-    auto it = formatCache_.find(cacheKey);
-    if (it != formatCache_.end()) {
-        return it->second;
+    std::string& cacheKey = cacheKeyBuf_;
+    cacheKey.clear();
+    i18n_fmt::format_to(std::back_inserter(cacheKey), "p:{}", amount);
+    if (const std::string* cached = formatCache_.find(cacheKey)) {
+        return *cached;
     }
     std::string result = formatPriceWithConfig(amount, defaultConfig.currency);
     formatCache_[cacheKey] = result;
     return result;
 }
 
+std::string I18N::formatPrice(double amount, std::string_view currency) const {
+    std::string result;
+    appendCurrency(result, amount, currencyFormatter(currency));
+    return result;
+}
+
+std::string I18N::formatCompact(int64_t value) const {
+    std::string result;
+    appendCompact(result, value);
+    return result;
+}
+
+std::string I18N::formatPercent(double ratio) const {
+    std::string result;
+    appendPercent(result, ratio);
+    return result;
+}
+
 std::string I18N::formatDate(std::string_view pattern, const std::tm* date) const {
     // Skip caching when date is nullptr (uses current time, never repeats)
     if (!date) {
         return formatDateWithConfig(pattern, date, defaultConfig.date_time);
     }
-    std::string cacheKey = i18n_fmt::format("d:{}:{}:{}:{}:{}:{}:{}", pattern, date->tm_year, date->tm_mon, date->tm_mday, date->tm_hour, date->tm_min, date->tm_sec);
-    auto it = formatCache_.find(cacheKey);
-    if (it != formatCache_.end()) {
-        return it->second;
+    std::string& cacheKey = cacheKeyBuf_;
+    cacheKey.clear();
+    i18n_fmt::format_to(std::back_inserter(cacheKey), "d:{}:{}:{}:{}:{}:{}:{}", pattern, date->tm_year, date->tm_mon, date->tm_mday, date->tm_hour, date->tm_min, date->tm_sec);
+    if (const std::string* cached = formatCache_.find(cacheKey)) {
+        return *cached;
     }
     std::string result = formatDateWithConfig(pattern, date, defaultConfig.date_time);
     formatCache_[cacheKey] = result;
@@ -1154,6 +3312,20 @@ const FormatConfig& I18N::getConfig() const noexcept {
     return defaultConfig;
 }
 
+// Overrides the fields of `config` present in a `_formats` currency object
+static void readCurrencyConfig(const json& currency, CurrencyConfig& config) {
+    if (currency.contains("symbol")) config.symbol = currency["symbol"].get<std::string>();
+    if (currency.contains("name")) config.name = currency["name"].get<std::string>();
+    if (currency.contains("short_name")) config.short_name = currency["short_name"].get<std::string>();
+    if (currency.contains("decimal_symbol")) config.decimal_symbol = currency["decimal_symbol"].get<std::string>();
+    if (currency.contains("thousand_separator")) config.thousand_separator = currency["thousand_separator"].get<std::string>();
+    if (currency.contains("fract_digits")) config.fract_digits = currency["fract_digits"].get<int>();
+    if (currency.contains("positive_symbol")) config.positive_symbol = currency["positive_symbol"].get<std::string>();
+    if (currency.contains("negative_symbol")) config.negative_symbol = currency["negative_symbol"].get<std::string>();
+    if (currency.contains("positive_format")) config.positive_format = currency["positive_format"].get<std::string>();
+    if (currency.contains("negative_format")) config.negative_format = currency["negative_format"].get<std::string>();
+}
+
 void I18N::configure(const json& formats) {
     if (!formats.is_object()) {
         return;
@@ -1163,17 +3335,25 @@ void I18N::configure(const json& formats) {
 
     try {
         if (formats.contains("currency") && formats["currency"].is_object()) {
-            const auto& currency = formats["currency"];
-            if (currency.contains("symbol")) tmp.currency.symbol = currency["symbol"].get<std::string>();
-            if (currency.contains("name")) tmp.currency.name = currency["name"].get<std::string>();
-            if (currency.contains("short_name")) tmp.currency.short_name = currency["short_name"].get<std::string>();
-            if (currency.contains("decimal_symbol")) tmp.currency.decimal_symbol = currency["decimal_symbol"].get<std::string>();
-            if (currency.contains("thousand_separator")) tmp.currency.thousand_separator = currency["thousand_separator"].get<std::string>();
-            if (currency.contains("fract_digits")) tmp.currency.fract_digits = currency["fract_digits"].get<int>();
-            if (currency.contains("positive_symbol")) tmp.currency.positive_symbol = currency["positive_symbol"].get<std::string>();
-            if (currency.contains("negative_symbol")) tmp.currency.negative_symbol = currency["negative_symbol"].get<std::string>();
-            if (currency.contains("positive_format")) tmp.currency.positive_format = currency["positive_format"].get<std::string>();
-            if (currency.contains("negative_format")) tmp.currency.negative_format = currency["negative_format"].get<std::string>();
+            readCurrencyConfig(formats["currency"], tmp.currency);
+            // Entries derived from the previous currency format are stale
+            tmp.currencies.clear();
+        }
+
+        // Other currencies by ISO 4217 code: the locale's currency format
+        // with the code as symbol, then the entry's own fields
+        if (formats.contains("currencies") && formats["currencies"].is_object()) {
+            for (const auto& [code, currency] : formats["currencies"].items()) {
+                CurrencyConfig config = tmp.currency;
+                config.symbol = code;
+                config.name = code;
+                config.short_name = code;
+                if (!currency.is_object()) {
+                    throw I18NError("locale config: currency " + code + " is not an object");
+                }
+                readCurrencyConfig(currency, config);
+                tmp.currencies[code] = std::move(config);
+            }
         }
 
 
@@ -1187,6 +3367,80 @@ void I18N::configure(const json& formats) {
         }
 
 
+        if (formats.contains("compact") && formats["compact"].is_object()) {
+            const auto& compact = formats["compact"];
+            if (compact.contains("suffixes")) tmp.compact.suffixes = compact["suffixes"].get<std::vector<std::string>>();
+            if (compact.contains("fract_digits")) tmp.compact.fract_digits = compact["fract_digits"].get<int>();
+        }
+
+        if (formats.contains("percent") && formats["percent"].is_object()) {
+            const auto& percent = formats["percent"];
+            if (percent.contains("prefix")) tmp.percent.prefix = percent["prefix"].get<std::string>();
+            if (percent.contains("suffix")) tmp.percent.suffix = percent["suffix"].get<std::string>();
+            if (percent.contains("fract_digits")) tmp.percent.fract_digits = percent["fract_digits"].get<int>();
+        }
+
+
+        // Relative time: a unit given replaces all of that unit's forms
+        if (formats.contains("relative") && formats["relative"].is_object()) {
+            const auto& relative = formats["relative"];
+            if (relative.contains("now")) tmp.relative.now = relative["now"].get<std::string>();
+            for (const char* direction : {"past", "future"}) {
+                if (!relative.contains(direction)) {
+                    continue;
+                }
+                auto& units = direction[0] == 'p' ? tmp.relative.past : tmp.relative.future;
+                for (const auto& [unit, forms] : relative[direction].items()) {
+                    auto& target = units[unit];
+                    target.clear();
+                    for (const auto& [category, text] : forms.items()) {
+                        target[category] = text.get<std::string>();
+                    }
+                }
+            }
+        }
+
+
+        if (formats.contains("list") && formats["list"].is_object()) {
+            const auto& list = formats["list"];
+            for (auto [name, target] : {std::pair{"pair", &tmp.list.pair}, std::pair{"start", &tmp.list.start},
+                                        std::pair{"middle", &tmp.list.middle}, std::pair{"end", &tmp.list.end}}) {
+                if (!list.contains(name)) {
+                    continue;
+                }
+                *target = list[name].get<std::string>();
+                ListPattern pattern;
+                if (!compileListPattern(*target, pattern)) {
+                    throw I18NError(std::string("locale config: list pattern '") + name + "' must contain {0} followed by {1}");
+                }
+            }
+        }
+
+        // Duration: a unit given replaces all of that unit's forms
+        if (formats.contains("duration") && formats["duration"].is_object()) {
+            const auto& duration = formats["duration"];
+            if (duration.contains("separator")) tmp.duration.separator = duration["separator"].get<std::string>();
+            if (duration.contains("max_units")) tmp.duration.max_units = duration["max_units"].get<int>();
+            if (duration.contains("units")) {
+                for (const auto& [unit, forms] : duration["units"].items()) {
+                    auto& target = tmp.duration.units[unit];
+                    target.clear();
+                    for (const auto& [category, text] : forms.items()) {
+                        target[category] = text.get<std::string>();
+                    }
+                }
+            }
+        }
+
+        // Ordinal: the categories given replace all forms
+        if (formats.contains("ordinal") && formats["ordinal"].is_object()) {
+            tmp.ordinal.forms.clear();
+            for (const auto& [category, text] : formats["ordinal"].items()) {
+                tmp.ordinal.forms[category] = text.get<std::string>();
+            }
+        }
+
+
         if (formats.contains("date_time") && formats["date_time"].is_object()) {
             const auto& date_time = formats["date_time"];
             if (date_time.contains("long_time")) tmp.date_time.long_time = date_time["long_time"].get<std::string>();
@@ -1240,10 +3494,22 @@ void I18N::configure(const json& formats) {
 
 void I18N::reset() {
     locales.clear();
+    keyIndex_.clear();
+    keyFilter_.clear();
+    keyTrie_.clear();
+    trieSegments_.clear();
+    variantIndex_.clear();
+    variantForms_.clear();
+    ++catalogGeneration_;
+    bundleCache_.clear();
     localesData.clear();
+    chain_.clear();
+    materializeFallbacks_ = false;
+    materializedChains_.clear();
+    activeMaterialized_ = nullptr;
     formatConfigs.clear();
-    formatCache_.clear();
-    translationCache_.clear();
+    clearFormatCache();
+    clearTranslationCache();
 
     defaultConfig = FormatConfig{};
     baselineConfig_ = FormatConfig{};
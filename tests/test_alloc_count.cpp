@@ -0,0 +1,277 @@
+// Allocation regression guard for the designated zero-allocation paths.
+//
+// This executable replaces the global operator new/delete with counting
+// versions, warms each path once, and then asserts that repeat calls perform
+// no heap allocation. Results are kept within the small-string buffer so the
+// only allocations that could show up are the library's own.
+
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+#include <string>
+
+namespace {
+
+std::atomic<size_t> g_allocCount{0};
+
+void* countedAlloc(std::size_t size) {
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+static std::string fixturesDir() {
+    return FIXTURES_DIR;
+}
+
+// Counts allocations performed by `fn` over `iterations` calls.
+template<typename Fn>
+static size_t countAllocs(Fn&& fn, int iterations = 100) {
+    size_t before = g_allocCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < iterations; ++i) {
+        fn();
+    }
+    return g_allocCount.load(std::memory_order_relaxed) - before;
+}
+
+class AllocCountTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.loadLocale("en", (fixturesDir() + "/en.json").c_str());
+        i18n.loadLocale("fr", (fixturesDir() + "/fr.json").c_str());
+        i18n.load({{"en-US", {{"settings", {{"privacy", {{"description_long_key", "Privacy"}}}}}}}});
+        i18n.setLocale("en-US");
+        i18n.setFallbackLocale("en");
+    }
+};
+
+TEST_F(AllocCountTest, CounterObservesAllocations) {
+    // Sanity check: the replacement operator new is actually in effect.
+    size_t allocs = countAllocs([] {
+        std::string s(64, 'x');
+        (void)s;
+    }, 1);
+    EXPECT_EQ(allocs, 1u);
+}
+
+TEST_F(AllocCountTest, TrCacheHitIsAllocationFree) {
+    (void)i18n.tr("greeting");
+    EXPECT_EQ(countAllocs([&] { (void)i18n.tr("greeting"); }), 0u);
+}
+
+TEST_F(AllocCountTest, TrCacheHitWithLongKeyIsAllocationFree) {
+    // Key is longer than the small-string buffer: the cache key must be built
+    // in the reusable scratch buffer rather than a fresh std::string.
+    const std::string_view key = "settings.privacy.description_long_key";
+    ASSERT_EQ(i18n.tr(key), "Privacy");
+    EXPECT_EQ(countAllocs([&] { (void)i18n.tr(key); }), 0u);
+}
+
+TEST_F(AllocCountTest, TrFallbackCacheHitIsAllocationFree) {
+    i18n.setLocale("fr");
+    ASSERT_EQ(i18n.tr("only_in_en"), "English only");
+    EXPECT_EQ(countAllocs([&] { (void)i18n.tr("only_in_en"); }), 0u);
+}
+
+TEST_F(AllocCountTest, TrWithParamsCacheHitIsAllocationFree) {
+    const std::string params[] = {"Al"};
+    ASSERT_EQ(i18n.tr("welcome", params), "Welcome, Al!");
+    EXPECT_EQ(countAllocs([&] { (void)i18n.tr("welcome", params); }), 0u);
+}
+
+TEST_F(AllocCountTest, TrWithStringViewParamsCacheHitIsAllocationFree) {
+    const std::string_view params[] = {"Al"};
+    ASSERT_EQ(i18n.tr("welcome", params), "Welcome, Al!");
+    EXPECT_EQ(countAllocs([&] { (void)i18n.tr("welcome", params); }), 0u);
+    EXPECT_EQ(countAllocs([&] { (void)i18n.tr("welcome", {"Al"}); }), 0u);
+}
+
+TEST_F(AllocCountTest, TrPluralWithParamsIsAllocationFree) {
+    // Params are not copied to prepend the count
+    ASSERT_EQ(i18n.trPlural("items_in_cart", 2, {"box"}), "2 items in box");
+    EXPECT_EQ(countAllocs([&] { (void)i18n.trPlural("items_in_cart", 2, {"box"}); }), 0u);
+}
+
+TEST_F(AllocCountTest, TrPluralCacheHitIsAllocationFree) {
+    ASSERT_EQ(i18n.trPlural("items_plural", 5), "5 items");
+    EXPECT_EQ(countAllocs([&] { (void)i18n.trPlural("items_plural", 5); }), 0u);
+}
+
+TEST_F(AllocCountTest, TrOrdinalCacheHitIsAllocationFree) {
+    ASSERT_EQ(i18n.trOrdinal("items_in_cart", 22, {"box"}), "22 items in box");
+    EXPECT_EQ(countAllocs([&] { (void)i18n.trOrdinal("items_in_cart", 22, {"box"}); }), 0u);
+}
+
+TEST_F(AllocCountTest, TrMissCacheHitIsAllocationFree) {
+    ASSERT_EQ(i18n.tr("not.a.key"), "not.a.key");
+    EXPECT_EQ(countAllocs([&] { (void)i18n.tr("not.a.key"); }), 0u);
+}
+
+TEST_F(AllocCountTest, TrPluralMissCacheHitIsAllocationFree) {
+    ASSERT_EQ(i18n.trPlural("not.a.key", 3), "not.a.key");
+    EXPECT_EQ(countAllocs([&] { (void)i18n.trPlural("not.a.key", 3); }), 0u);
+}
+
+TEST_F(AllocCountTest, TranslateCacheHitIsAllocationFree) {
+    const nlohmann::json params = {{"name", "Al"}, {"ts", 12345}};
+    ASSERT_EQ(i18n.translate("welcome_named", params), "Al has arrived");
+    EXPECT_EQ(countAllocs([&] { (void)i18n.translate("welcome_named", params); }), 0u);
+}
+
+TEST_F(AllocCountTest, TrfIntoReusedBufferIsAllocationFree) {
+    i18n.load({{"xx", {{"total", "{0}: {1:number} / {2:price}"}}}});
+    i18n.setLocale("xx");
+    const i18n::FormatArg args[] = {"Total", 1234.5, 99};
+    std::string out;
+    i18n.trfInto(out, "total", args);
+    ASSERT_EQ(out, "Total: 1 234.50 / XXX 99.00");
+    EXPECT_EQ(countAllocs([&] {
+        out.clear();
+        i18n.trfInto(out, "total", args);
+    }), 0u);
+}
+
+TEST_F(AllocCountTest, EscapedTrfIntoReusedBufferIsAllocationFree) {
+    i18n.load({{"xx", {{"total", "<b>{0}</b>: {1:number}"}}}});
+    i18n.setLocale("xx");
+    const i18n::FormatArg args[] = {"Tom & Jerry", 1234.5};
+    std::string out;
+    i18n.trfInto(out, "total", args, i18n::Escape::Html);
+    ASSERT_EQ(out, "&lt;b&gt;Tom &amp; Jerry&lt;/b&gt;: 1 234.50");
+    EXPECT_EQ(countAllocs([&] {
+        out.clear();
+        i18n.trfInto(out, "total", args, i18n::Escape::Html);
+    }), 0u);
+}
+
+TEST_F(AllocCountTest, TrfSegmentsReusedOutputIsAllocationFree) {
+    i18n.load({{"xx", {{"welcome", "Welcome back, {0}! You have {1} new messages."}}}});
+    i18n.setLocale("xx");
+    const i18n::FormatArg args[] = {"Ann", 42};
+    i18n::SegmentedOutput out;
+    i18n.trfSegments(out, "welcome", args);
+    ASSERT_EQ(out.str(), "Welcome back, Ann! You have 42 new messages.");
+    EXPECT_EQ(countAllocs([&] { i18n.trfSegments(out, "welcome", args); }), 0u);
+}
+
+TEST_F(AllocCountTest, DiscardedMessageIsAllocationFree) {
+    const std::string name = "Ann";
+    EXPECT_EQ(countAllocs([&] {
+        auto message = i18n.msg("welcome", name, 42, 3.5);
+        volatile size_t n = message.args().size();
+        (void)n;
+    }), 0u);
+}
+
+TEST_F(AllocCountTest, MessageAppendToReusedBufferIsAllocationFree) {
+    i18n.load({{"xx", {{"welcome", "Welcome back, {0}! You have {1} new messages."}}}});
+    i18n.setLocale("xx");
+    std::string out;
+    i18n.msg("welcome", "Ann", 42).appendTo(out);
+    ASSERT_EQ(out, "Welcome back, Ann! You have 42 new messages.");
+    EXPECT_EQ(countAllocs([&] {
+        out.clear();
+        i18n.msg("welcome", "Ann", 42).appendTo(out);
+    }), 0u);
+}
+
+#if defined(I18N_HAS_STD_FORMATTER) || defined(I18N_HAS_FMT_FORMATTER)
+TEST_F(AllocCountTest, FormattedMessageIntoReusedBufferIsAllocationFree) {
+    i18n.load({{"xx", {{"status", "{0} new messages"}}}});
+    i18n.setLocale("xx");
+    std::string out;
+    const auto render = [&] {
+        out.clear();
+#ifdef I18N_HAS_STD_FORMATTER
+        std::format_to(std::back_inserter(out), "{}: {}", "Inbox", i18n.msg("status", 42));
+#else
+        fmt::format_to(std::back_inserter(out), "{}: {}", "Inbox", i18n.msg("status", 42));
+#endif
+    };
+    render();
+    ASSERT_EQ(out, "Inbox: 42 new messages");
+    EXPECT_EQ(countAllocs(render), 0u);
+}
+#endif
+
+TEST_F(AllocCountTest, FormatCompactAndPercentAreAllocationFree) {
+    ASSERT_EQ(i18n.formatCompact(1234567), "1.2M");
+    EXPECT_EQ(countAllocs([&] {
+        volatile size_t n = i18n.formatCompact(1234567).size() + i18n.formatPercent(0.256).size();
+        (void)n;
+    }), 0u);
+}
+
+TEST_F(AllocCountTest, FormatRelativeBatchReusedOutputIsAllocationFree) {
+    const std::chrono::seconds deltas[] = {
+        std::chrono::seconds(-5), std::chrono::seconds(-300), std::chrono::seconds(-320),
+        std::chrono::seconds(-7200), std::chrono::seconds(86400 * 3)
+    };
+    i18n::BatchOutput out;
+    i18n.formatRelativeBatch(deltas, out);
+    ASSERT_EQ(out[1], "5 minutes ago");
+    EXPECT_EQ(countAllocs([&] { i18n.formatRelativeBatch(deltas, out); }), 0u);
+}
+
+TEST_F(AllocCountTest, FormatListAndDurationIntoReusedBufferAreAllocationFree) {
+    const std::string_view items[] = {"alpha", "beta", "gamma", "delta"};
+    std::string out;
+    i18n.formatListInto(out, items);
+    i18n.formatDurationInto(out, std::chrono::seconds(8130));
+    ASSERT_EQ(out, "alpha, beta, gamma, and delta2 h 15 min 30 s");
+    EXPECT_EQ(countAllocs([&] {
+        out.clear();
+        i18n.formatListInto(out, items);
+        i18n.formatDurationInto(out, std::chrono::seconds(8130));
+    }), 0u);
+}
+
+TEST_F(AllocCountTest, FormatOrdinalIsAllocationFree) {
+    std::string out;
+    i18n.formatOrdinalInto(out, 1021);
+    ASSERT_EQ(out, "1021st");
+    ASSERT_EQ(i18n.formatOrdinal(3), "3rd");
+    EXPECT_EQ(countAllocs([&] {
+        out.clear();
+        i18n.formatOrdinalInto(out, 1021);
+        (void)i18n.formatOrdinal(3);
+    }), 0u);
+}
+
+TEST_F(AllocCountTest, FormatNumberCacheHitIsAllocationFree) {
+    (void)i18n.formatNumber(999.99);
+    EXPECT_EQ(countAllocs([&] { (void)i18n.formatNumber(999.99); }), 0u);
+}
+
+TEST_F(AllocCountTest, FormatPriceCacheHitIsAllocationFree) {
+    (void)i18n.formatPrice(49.95);
+    EXPECT_EQ(countAllocs([&] { (void)i18n.formatPrice(49.95); }), 0u);
+}
+
+TEST_F(AllocCountTest, FormatDateCacheHitIsAllocationFree) {
+    std::tm tm = {};
+    tm.tm_year = 126;
+    tm.tm_mon = 3;
+    tm.tm_mday = 9;
+    tm.tm_hour = 14;
+    tm.tm_min = 30;
+    (void)i18n.formatDate("short_time", &tm);
+    EXPECT_EQ(countAllocs([&] { (void)i18n.formatDate("short_time", &tm); }), 0u);
+}
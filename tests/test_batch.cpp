@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <string>
+#include <vector>
+
+static std::string fixturesDir() {
+    return FIXTURES_DIR;
+}
+
+class BatchTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.loadLocale("en", (fixturesDir() + "/en.json").c_str());
+        i18n.loadLocale("fr", (fixturesDir() + "/fr.json").c_str());
+        i18n.setLocale("en");
+        i18n.setFallbackLocale("en");
+    }
+};
+
+TEST_F(BatchTest, EmptyBatch) {
+    i18n::BatchOutput out;
+    i18n.trBatch({}, out);
+    EXPECT_TRUE(out.empty());
+    EXPECT_TRUE(out.arena().empty());
+}
+
+TEST_F(BatchTest, ResultsFollowRequestOrder) {
+    std::vector<i18n::KeyRequest> requests = {
+        {"greeting"}, {"menu.file.open"}, {"farewell"}, {"deep.nested.key"}
+    };
+    i18n::BatchOutput out;
+    i18n.trBatch(requests, out);
+
+    ASSERT_EQ(out.size(), 4u);
+    EXPECT_EQ(out[0], "Hello");
+    EXPECT_EQ(out[1], "Open");
+    EXPECT_EQ(out[2], "Goodbye");
+    EXPECT_EQ(out[3], "Deep value");
+}
+
+TEST_F(BatchTest, MatchesTrForEveryKind) {
+    const std::string name[] = {"Alice"};
+    const std::string two[] = {"Alice", "Wonderland"};
+    std::vector<i18n::KeyRequest> requests = {
+        {"welcome", name},
+        {"welcome_pos", two},
+        {"welcome_unnamed", two},
+        {"items_plural"},          // resolves through .other like tr()
+        {"nonexistent.key"},       // missing key returns the key itself
+        {""},                      // empty key returns empty string
+    };
+    i18n::BatchOutput out;
+    i18n.trBatch(requests, out);
+
+    ASSERT_EQ(out.size(), requests.size());
+    for (size_t i = 0; i < requests.size(); ++i) {
+        EXPECT_EQ(out[i], i18n.tr(requests[i].key, requests[i].params)) << "request " << i;
+    }
+}
+
+TEST_F(BatchTest, UsesFallbackChain) {
+    i18n.setLocale("fr");
+    std::vector<i18n::KeyRequest> requests = {{"greeting"}, {"only_in_en"}, {"menu.file.close"}};
+    i18n::BatchOutput out;
+    i18n.trBatch(requests, out);
+
+    EXPECT_EQ(out[0], "Bonjour");
+    EXPECT_EQ(out[1], "English only");
+    EXPECT_EQ(out[2], "Close");
+}
+
+TEST_F(BatchTest, DuplicateKeysShareArenaBytes) {
+    const std::string bob[] = {"Bob"};
+    std::vector<i18n::KeyRequest> requests = {
+        {"greeting"}, {"farewell"}, {"greeting"}, {"welcome", bob}, {"greeting"}
+    };
+    i18n::BatchOutput out;
+    i18n.trBatch(requests, out);
+
+    EXPECT_EQ(out[0], "Hello");
+    EXPECT_EQ(out[2], "Hello");
+    EXPECT_EQ(out[4], "Hello");
+    EXPECT_EQ(out[3], "Welcome, Bob!");
+    // Plain duplicates point at the same arena bytes
+    EXPECT_EQ(out[0].data(), out[2].data());
+    EXPECT_EQ(out[0].data(), out[4].data());
+}
+
+TEST_F(BatchTest, OutputIsReusedAcrossCalls) {
+    i18n::BatchOutput out;
+    std::vector<i18n::KeyRequest> first = {{"greeting"}, {"farewell"}};
+    i18n.trBatch(first, out);
+    ASSERT_EQ(out.size(), 2u);
+
+    std::vector<i18n::KeyRequest> second = {{"menu.edit.copy"}};
+    i18n.trBatch(second, out);
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_EQ(out[0], "Copy");
+    EXPECT_EQ(out.arena(), "Copy");
+}
+
+TEST_F(BatchTest, DoesNotTouchTranslationCache) {
+    std::vector<i18n::KeyRequest> requests = {{"greeting"}, {"farewell"}};
+    i18n::BatchOutput out;
+    i18n.trBatch(requests, out);
+    EXPECT_EQ(i18n.translationCacheSize(), 0u);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+using i18n::BundleFormat;
+
+class BundleTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.load({
+            {"en", {
+                {"settings", {
+                    {"title", "Settings"},
+                    {"privacy", {{"title", "Privacy"}, {"note", "Say \"no\"\tto\\tracking\n"}}}
+                }},
+                {"greeting", "Hello {0}"}
+            }},
+            {"de", {
+                {"settings", {{"title", "Einstellungen"}}}
+            }}
+        });
+        i18n.setLocale("de");
+        i18n.setFallbackLocale("en");
+    }
+
+    // Decodes a Binary bundle back into (key, value) pairs
+    static std::vector<std::pair<std::string, std::string>> decode(std::string_view bundle) {
+        std::vector<std::pair<std::string, std::string>> entries;
+        EXPECT_EQ(bundle.substr(0, 5), std::string_view("I18B\x01", 5));
+        size_t pos = 5;
+        auto varint = [&] {
+            uint64_t value = 0;
+            for (unsigned shift = 0;; shift += 7) {
+                const auto byte = static_cast<unsigned char>(bundle[pos++]);
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return value;
+            }
+        };
+        uint64_t count = varint();
+        for (uint64_t i = 0; i < count; ++i) {
+            size_t keyLength = varint();
+            std::string key(bundle.substr(pos, keyLength));
+            pos += keyLength;
+            size_t valueLength = varint();
+            std::string value(bundle.substr(pos, valueLength));
+            pos += valueLength;
+            entries.emplace_back(std::move(key), std::move(value));
+        }
+        EXPECT_EQ(pos, bundle.size());
+        return entries;
+    }
+};
+
+TEST_F(BundleTest, JsonMatchesSubtree) {
+    std::string_view bundle = i18n.renderBundle("settings");
+    i18n::json parsed = i18n::json::parse(bundle);
+    auto subtree = i18n.trSubtree("settings");
+    ASSERT_EQ(parsed.size(), subtree.size());
+    for (const auto& [key, value] : subtree) {
+        EXPECT_EQ(parsed[key].get<std::string>(), value) << key;
+    }
+    EXPECT_EQ(parsed["settings.title"], "Einstellungen");
+    EXPECT_EQ(parsed["settings.privacy.note"], "Say \"no\"\tto\\tracking\n");
+}
+
+TEST_F(BundleTest, JsonLayout) {
+    EXPECT_EQ(i18n.renderBundle("greeting"), "{\"greeting\":\"Hello {0}\"}");
+    EXPECT_EQ(i18n.renderBundle("missing"), "{}");
+}
+
+TEST_F(BundleTest, BinaryMatchesSubtree) {
+    EXPECT_EQ(decode(i18n.renderBundle("settings", BundleFormat::Binary)), i18n.trSubtree("settings"));
+    EXPECT_TRUE(decode(i18n.renderBundle("missing", BundleFormat::Binary)).empty());
+}
+
+TEST_F(BundleTest, RepeatCallsReturnCachedBytes) {
+    std::string_view first = i18n.renderBundle("settings");
+    std::string_view second = i18n.renderBundle("settings");
+    EXPECT_EQ(first.data(), second.data());
+    EXPECT_NE(i18n.renderBundle("settings", BundleFormat::Binary).data(), first.data());
+}
+
+TEST_F(BundleTest, CachedPerLocaleChain) {
+    std::string_view german = i18n.renderBundle("settings.title");
+    i18n.setLocale("en");
+    std::string_view english = i18n.renderBundle("settings.title");
+    EXPECT_EQ(english, "{\"settings.title\":\"Settings\"}");
+    i18n.setLocale("de");
+    EXPECT_EQ(i18n.renderBundle("settings.title").data(), german.data());
+    EXPECT_EQ(german, "{\"settings.title\":\"Einstellungen\"}");
+}
+
+TEST_F(BundleTest, CatalogChangeStartsNewGeneration) {
+    uint64_t generation = i18n.catalogGeneration();
+    EXPECT_EQ(i18n.renderBundle("settings.title"), "{\"settings.title\":\"Einstellungen\"}");
+
+    i18n.load({{"de", {{"settings", {{"title", "Optionen"}}}}}});
+    EXPECT_GT(i18n.catalogGeneration(), generation);
+    EXPECT_EQ(i18n.renderBundle("settings.title"), "{\"settings.title\":\"Optionen\"}");
+
+    generation = i18n.catalogGeneration();
+    i18n.setLocale("en");
+    EXPECT_EQ(i18n.catalogGeneration(), generation);
+}
+
+TEST_F(BundleTest, TrailingDotSharesCacheEntry) {
+    std::string_view plain = i18n.renderBundle("settings");
+    EXPECT_EQ(i18n.renderBundle("settings.").data(), plain.data());
+    EXPECT_EQ(i18n.bundleCacheSize(), 1u);
+}
+
+TEST_F(BundleTest, UnknownPrefixesAreNotCached) {
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(i18n.renderBundle("nope." + std::to_string(i)), "{}");
+    }
+    EXPECT_EQ(i18n.bundleCacheSize(), 0u);
+    EXPECT_TRUE(decode(i18n.renderBundle("nope", BundleFormat::Binary)).empty());
+}
+
+TEST_F(BundleTest, CacheIsBounded) {
+    i18n::json section = i18n::json::object();
+    for (int i = 0; i < 1000; ++i) {
+        section["k" + std::to_string(i)] = "v";
+    }
+    i18n.load({{"de", {{"many", section}}}});
+    for (int i = 0; i < 1000; ++i) {
+        (void)i18n.renderBundle("many.k" + std::to_string(i));
+    }
+    EXPECT_LE(i18n.bundleCacheSize(), 256u);
+    EXPECT_EQ(i18n.renderBundle("many.k999"), "{\"many.k999\":\"v\"}");
+}
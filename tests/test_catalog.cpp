@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// Catalog layout: one shared key index, one value column per locale.
+
+class CatalogTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.load({
+            {"en", {
+                {"greeting", "Hello"},
+                {"farewell", "Goodbye"},
+                {"only_en", "English only"},
+                {"apples", {{"one", "{0} apple"}, {"other", "{0} apples"}}},
+                {"menu", {{"open", "Open"}, {"close", "Close"}}}
+            }},
+            {"de", {
+                {"greeting", "Hallo"},
+                {"apples", {{"other", "{0} Äpfel"}}},
+                {"menu", {{"open", "Öffnen"}}}
+            }},
+            {"pl", {
+                {"apples", {{"one", "{0} jabłko"}, {"few", "{0} jabłka"}, {"many", "{0} jabłek"}}}
+            }}
+        });
+        i18n.setLocale("de");
+        i18n.setFallbackLocale("en");
+    }
+
+    static std::vector<std::string> sorted(std::vector<std::string> keys) {
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    }
+};
+
+TEST_F(CatalogTest, ResolvesThroughFallbackChain) {
+    EXPECT_EQ(i18n.tr("greeting"), "Hallo");
+    EXPECT_EQ(i18n.tr("menu.open"), "Öffnen");
+    EXPECT_EQ(i18n.tr("menu.close"), "Close");
+    EXPECT_EQ(i18n.tr("only_en"), "English only");
+    EXPECT_EQ(i18n.tr("missing.key"), "missing.key");
+}
+
+TEST_F(CatalogTest, TrFallsBackToOtherForm) {
+    EXPECT_EQ(i18n.tr("apples", {"3"}), "3 Äpfel");
+    i18n.setLocale("pl");
+    // pl has no "other" form: the en one is used
+    EXPECT_EQ(i18n.tr("apples", {"3"}), "3 apples");
+}
+
+TEST_F(CatalogTest, PluralFormsFollowEachLocalesRules) {
+    i18n.setLocale("pl");
+    EXPECT_EQ(i18n.trPlural("apples", 1), "1 jabłko");
+    EXPECT_EQ(i18n.trPlural("apples", 3), "3 jabłka");
+    EXPECT_EQ(i18n.trPlural("apples", 5), "5 jabłek");
+    i18n.setLocale("de");
+    EXPECT_EQ(i18n.trPlural("apples", 1), "1 Äpfel");
+}
+
+TEST_F(CatalogTest, MissingKeysScansColumn) {
+    EXPECT_EQ(sorted(i18n.missingKeys("de")),
+              (std::vector<std::string>{"apples.few", "apples.many", "apples.one",
+                                        "farewell", "menu.close", "only_en"}));
+    EXPECT_EQ(sorted(i18n.missingKeys("en")),
+              (std::vector<std::string>{"apples.few", "apples.many"}));
+    EXPECT_EQ(i18n.missingKeys("pl").size(), 6u);
+}
+
+TEST_F(CatalogTest, MissingKeysForUnknownLocaleListsEverything) {
+    EXPECT_EQ(i18n.missingKeys("ja").size(), 9u);
+}
+
+TEST_F(CatalogTest, ReloadDropsOldValuesButKeepsOtherLocales) {
+    i18n.load({{"de", {{"farewell", "Tschüss"}}}});
+    EXPECT_EQ(i18n.tr("greeting"), "Hello");
+    EXPECT_EQ(i18n.tr("farewell"), "Tschüss");
+    auto missing = i18n.missingKeys("de");
+    EXPECT_EQ(std::count(missing.begin(), missing.end(), "greeting"), 1);
+    EXPECT_EQ(std::count(missing.begin(), missing.end(), "farewell"), 0);
+}
+
+TEST_F(CatalogTest, NewLocaleJoinsExistingChain) {
+    i18n.setLocale(std::vector<std::string>{"de-AT", "de"});
+    EXPECT_EQ(i18n.tr("greeting"), "Hallo");
+    i18n.load({{"de-AT", {{"greeting", "Servus"}}}});
+    EXPECT_EQ(i18n.tr("greeting"), "Servus");
+}
+
+TEST_F(CatalogTest, KeyExistsUsesChain) {
+    EXPECT_TRUE(i18n.keyExists("menu.close"));
+    EXPECT_TRUE(i18n.keyExists("apples"));
+    EXPECT_FALSE(i18n.keyExists("menu"));
+    EXPECT_FALSE(i18n.keyExists("nope"));
+}
+
+TEST_F(CatalogTest, ResetClearsKeyIndex) {
+    i18n.reset();
+    EXPECT_TRUE(i18n.missingKeys("en").empty());
+    EXPECT_EQ(i18n.tr("greeting"), "greeting");
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <cstdint>
+#include <limits>
+#include <string>
+
+class CompactPercentTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.load(nlohmann::json::parse(R"json({
+            "de": {
+                "_formats": {
+                    "number": {"decimal_symbol": ",", "thousand_separator": "."},
+                    "compact": {"suffixes": ["", " Mio.", " Mrd.", " Bio."]},
+                    "percent": {"suffix": " %", "fract_digits": 1}
+                }
+            },
+            "en": {
+                "_formats": {
+                    "number": {"decimal_symbol": ".", "thousand_separator": ","},
+                    "compact": {"suffixes": ["K", "M", "B", "T"]},
+                    "percent": {"suffix": "%", "fract_digits": 0}
+                },
+                "followers": "{0:compact} followers, {1:percent} active"
+            }
+        })json"));
+        i18n.setLocale("en");
+    }
+};
+
+TEST_F(CompactPercentTest, CompactAbbreviatesMagnitudes) {
+    EXPECT_EQ(i18n.formatCompact(0), "0");
+    EXPECT_EQ(i18n.formatCompact(999), "999");
+    EXPECT_EQ(i18n.formatCompact(1000), "1K");
+    EXPECT_EQ(i18n.formatCompact(1234), "1.2K");
+    EXPECT_EQ(i18n.formatCompact(12345), "12.3K");
+    EXPECT_EQ(i18n.formatCompact(3400000), "3.4M");
+    EXPECT_EQ(i18n.formatCompact(7000000000), "7B");
+    EXPECT_EQ(i18n.formatCompact(-1500), "-1.5K");
+}
+
+TEST_F(CompactPercentTest, CompactRoundsHalfToEven) {
+    EXPECT_EQ(i18n.formatCompact(1250), "1.2K");
+    EXPECT_EQ(i18n.formatCompact(1350), "1.4K");
+    EXPECT_EQ(i18n.formatCompact(1251), "1.3K");
+}
+
+TEST_F(CompactPercentTest, CompactCarriesIntoNextMagnitude) {
+    EXPECT_EQ(i18n.formatCompact(999950), "1M");
+    EXPECT_EQ(i18n.formatCompact(999949), "999.9K");
+}
+
+TEST_F(CompactPercentTest, CompactBeyondTableStaysInLastSuffix) {
+    EXPECT_EQ(i18n.formatCompact(std::numeric_limits<int64_t>::max()), "9,223,372T");
+    EXPECT_EQ(i18n.formatCompact(std::numeric_limits<int64_t>::min()), "-9,223,372T");
+}
+
+TEST_F(CompactPercentTest, CompactUsesLocaleTable) {
+    i18n.setLocale("de");
+    EXPECT_EQ(i18n.formatCompact(12345), "12.345");
+    EXPECT_EQ(i18n.formatCompact(3400000), "3,4 Mio.");
+    EXPECT_EQ(i18n.formatCompact(2000000000), "2 Mrd.");
+}
+
+TEST_F(CompactPercentTest, PercentScalesAndRounds) {
+    EXPECT_EQ(i18n.formatPercent(0.256), "26%");
+    EXPECT_EQ(i18n.formatPercent(0.125), "12%");
+    EXPECT_EQ(i18n.formatPercent(12.5), "1,250%");
+    EXPECT_EQ(i18n.formatPercent(-0.5), "-50%");
+    EXPECT_EQ(i18n.formatPercent(-0.001), "0%");
+}
+
+TEST_F(CompactPercentTest, PercentUsesLocaleFormat) {
+    i18n.setLocale("de");
+    EXPECT_EQ(i18n.formatPercent(0.256), "25,6 %");
+    EXPECT_EQ(i18n.formatPercent(1.0), "100,0 %");
+}
+
+TEST_F(CompactPercentTest, PercentHandlesNonFinite) {
+    EXPECT_EQ(i18n.formatPercent(std::numeric_limits<double>::quiet_NaN()), "0%");
+    EXPECT_FALSE(i18n.formatPercent(std::numeric_limits<double>::infinity()).empty());
+}
+
+TEST_F(CompactPercentTest, TypedPlaceholders) {
+    EXPECT_EQ(i18n.trf("followers", {12345, 0.42}), "12.3K followers, 42% active");
+}
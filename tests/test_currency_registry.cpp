@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <string>
+
+class CurrencyRegistryTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.load(nlohmann::json::parse(R"json({
+            "en": {
+                "_formats": {
+                    "currency": {
+                        "symbol": "$", "short_name": "USD", "decimal_symbol": ".", "thousand_separator": ",",
+                        "positive_format": "%c%q", "negative_format": "-%c%q", "negative_symbol": ""
+                    },
+                    "currencies": {
+                        "EUR": {"symbol": "€"},
+                        "JPY": {"symbol": "¥", "fract_digits": 0},
+                        "CHF": {"positive_format": "%c %q", "negative_format": "%c -%q"}
+                    }
+                },
+                "total": "Total: {0:price:EUR} ({0:price})"
+            },
+            "de": {
+                "_formats": {
+                    "currency": {
+                        "symbol": "€", "short_name": "EUR", "decimal_symbol": ",", "thousand_separator": ".",
+                        "positive_format": "%q %c", "negative_format": "-%q %c", "negative_symbol": ""
+                    },
+                    "currencies": {
+                        "USD": {"symbol": "$"}
+                    }
+                }
+            }
+        })json"));
+        i18n.setLocale("en");
+    }
+};
+
+TEST_F(CurrencyRegistryTest, FormatsRegisteredCurrencies) {
+    EXPECT_EQ(i18n.formatPrice(1234.5, "EUR"), "€1,234.50");
+    EXPECT_EQ(i18n.formatPrice(1234.5, "JPY"), "¥1,235");
+    EXPECT_EQ(i18n.formatPrice(-9.99, "CHF"), "CHF -9.99");
+}
+
+TEST_F(CurrencyRegistryTest, LocaleCurrencyMatchesItsCode) {
+    EXPECT_EQ(i18n.formatPrice(1234.5, "USD"), i18n.formatPrice(1234.5));
+    EXPECT_EQ(i18n.formatPrice(-3.0, "USD"), "-$3.00");
+}
+
+TEST_F(CurrencyRegistryTest, UnknownCodeUsesCodeAsSymbol) {
+    EXPECT_EQ(i18n.formatPrice(12.0, "SEK"), "SEK12.00");
+}
+
+TEST_F(CurrencyRegistryTest, FollowsActiveLocale) {
+    i18n.setLocale("de");
+    EXPECT_EQ(i18n.formatPrice(1234.5, "USD"), "1.234,50 $");
+    EXPECT_EQ(i18n.formatPrice(1234.5, "EUR"), "1.234,50 €");
+    i18n.setLocale("en");
+    EXPECT_EQ(i18n.formatPrice(1234.5, "USD"), "$1,234.50");
+}
+
+TEST_F(CurrencyRegistryTest, SwitchingCurrencyKeepsConfig) {
+    const std::string before = i18n.formatPrice(5.0);
+    i18n.formatPrice(5.0, "EUR");
+    i18n.formatPrice(5.0, "JPY");
+    EXPECT_EQ(i18n.formatPrice(5.0), before);
+    EXPECT_EQ(i18n.getConfig().currency.short_name, "USD");
+    EXPECT_EQ(i18n.getConfig().currencies.size(), 3u);
+}
+
+TEST_F(CurrencyRegistryTest, ConfigureReplacesCompiledFormat) {
+    EXPECT_EQ(i18n.formatPrice(1.0, "EUR"), "€1.00");
+    i18n.configure(nlohmann::json::parse(R"({"currencies": {"EUR": {"symbol": "EUR "}}})"));
+    EXPECT_EQ(i18n.formatPrice(1.0, "EUR"), "EUR 1.00");
+}
+
+TEST_F(CurrencyRegistryTest, TypedPlaceholderTakesCode) {
+    EXPECT_EQ(i18n.trf("total", {1234.5}), "Total: €1,234.50 ($1,234.50)");
+}
+
+TEST_F(CurrencyRegistryTest, NonObjectEntryThrows) {
+    EXPECT_THROW(i18n.configure(nlohmann::json::parse(R"({"currencies": {"EUR": "€"}})")), i18n::I18NError);
+    EXPECT_EQ(i18n.formatPrice(1.0, "EUR"), "€1.00");
+}
+
+TEST_F(CurrencyRegistryTest, ResetDropsCompiledFormatters) {
+    EXPECT_EQ(i18n.formatPrice(1.5, "EUR"), "€1.50");
+    i18n.reset();
+    EXPECT_EQ(i18n.formatPrice(1.5, "EUR"), i18n::I18N().formatPrice(1.5, "EUR"));
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <string>
+
+using i18n::Escape;
+
+class EscapingTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.load({
+            {"en", {
+                {"greeting", "Hello <b>{0}</b> & \"friends\""},
+                {"quote", "She said \"{0}\"\n"},
+                {"search", "q={0} & more"},
+                {"total", "Total {0,10:number} <{1:date:%d/%m}>"},
+                {"plain", "Nothing to escape here, {0}."},
+                {"long", "A long literal run without anything special, then <{0}> and a tail of text."}
+            }}
+        });
+        i18n.setLocale("en");
+    }
+};
+
+TEST_F(EscapingTest, HtmlEscapesLiteralsAndArgs) {
+    EXPECT_EQ(i18n.trf("greeting", {"Tom & 'Jerry'"}, Escape::Html),
+              "Hello &lt;b&gt;Tom &amp; &#39;Jerry&#39;&lt;/b&gt; &amp; &quot;friends&quot;");
+}
+
+TEST_F(EscapingTest, JsonEscapesStringContents) {
+    EXPECT_EQ(i18n.trf("quote", {"a\\b\t\x01"}, Escape::Json), "She said \\\"a\\\\b\\t\\u0001\\\"\\n");
+}
+
+TEST_F(EscapingTest, UrlPercentEncodesComponent) {
+    EXPECT_EQ(i18n.trf("search", {"caf\xC3\xA9 au lait"}, Escape::Url),
+              "q%3Dcaf%C3%A9%20au%20lait%20%26%20more");
+}
+
+TEST_F(EscapingTest, FormattedArgsAndPaddingAreEscaped) {
+    std::tm tm = {};
+    tm.tm_mon = 2;
+    tm.tm_mday = 15;
+    EXPECT_EQ(i18n.trf("total", {1234.5, tm}, Escape::Html), "Total   1 234.50 &lt;15/03&gt;");
+    EXPECT_EQ(i18n.trf("total", {1234.5, tm}, Escape::Url), "Total%20%20%201%20234.50%20%3C15%2F03%3E");
+}
+
+TEST_F(EscapingTest, UnescapedOutputIsUnchanged) {
+    EXPECT_EQ(i18n.trf("greeting", {"<i>"}), "Hello <b><i></b> & \"friends\"");
+    EXPECT_EQ(i18n.trf("greeting", {"<i>"}, Escape::None), "Hello <b><i></b> & \"friends\"");
+}
+
+TEST_F(EscapingTest, ModesAreCachedSeparately) {
+    EXPECT_EQ(i18n.trf("plain", {"<x>"}, Escape::Html), "Nothing to escape here, &lt;x&gt;.");
+    EXPECT_EQ(i18n.trf("plain", {"<x>"}), "Nothing to escape here, <x>.");
+    EXPECT_EQ(i18n.trf("plain", {"<x>"}, Escape::Url), "Nothing%20to%20escape%20here%2C%20%3Cx%3E.");
+    EXPECT_EQ(i18n.trf("plain", {"<x>"}, Escape::Html), "Nothing to escape here, &lt;x&gt;.");
+}
+
+TEST_F(EscapingTest, LongRunsMatchScalarEscaping) {
+    // Exercises the 16-byte scan on both sides of an escapable byte
+    const std::string arg = "0123456789abcdef0123456789\"&<>'0123456789abcdef";
+    EXPECT_EQ(i18n.trf("long", {arg}, Escape::Html),
+              "A long literal run without anything special, then &lt;0123456789abcdef0123456789"
+              "&quot;&amp;&lt;&gt;&#39;0123456789abcdef&gt; and a tail of text.");
+    EXPECT_EQ(i18n.trf("long", {std::string(40, 'x') + "\x1f\x7f\x80"}, Escape::Json),
+              "A long literal run without anything special, then <" + std::string(40, 'x') + "\\u001f\x7f\x80> and a tail of text.");
+}
+
+TEST_F(EscapingTest, MissingKeyIsEscaped) {
+    EXPECT_EQ(i18n.trf("a<b", {}, Escape::Html), "a&lt;b");
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <string>
+#include <unordered_map>
+
+using i18n::FlatStringMap;
+
+TEST(FlatStringMap, EmptyTableFindsNothing) {
+    FlatStringMap<std::string> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find("anything"), nullptr);
+    EXPECT_EQ(map.findIndex("anything"), FlatStringMap<std::string>::npos);
+    map.clear(); // clear on a never-used table is a no-op
+    map.prefetch(FlatStringMap<std::string>::hashOf("anything"));
+}
+
+TEST(FlatStringMap, InsertFindAndOverwrite) {
+    FlatStringMap<std::string> map;
+    map["greeting"] = "Hello";
+    map[std::string("farewell")] = "Goodbye";
+    ASSERT_EQ(map.size(), 2u);
+
+    ASSERT_NE(map.find("greeting"), nullptr);
+    EXPECT_EQ(*map.find("greeting"), "Hello");
+    EXPECT_EQ(*map.find(std::string_view("farewell")), "Goodbye");
+
+    map["greeting"] = "Hi";
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_EQ(*map.find("greeting"), "Hi");
+}
+
+TEST(FlatStringMap, EntriesKeepInsertionOrderAndHash) {
+    FlatStringMap<int> map;
+    map["c"] = 3;
+    map["a"] = 1;
+    map["b"] = 2;
+
+    std::string order;
+    for (const auto& entry : map) {
+        order += entry.key;
+        EXPECT_EQ(entry.hash, FlatStringMap<int>::hashOf(entry.key));
+    }
+    EXPECT_EQ(order, "cab");
+    EXPECT_EQ(map.findIndex("a"), 1u);
+    EXPECT_EQ(map.entryAt(2).value, 2);
+}
+
+TEST(FlatStringMap, GrowthMatchesReferenceMap) {
+    FlatStringMap<std::string> map;
+    std::unordered_map<std::string, std::string> reference;
+    for (int i = 0; i < 5000; ++i) {
+        std::string key = "section_" + std::to_string(i % 97) + ".item_" + std::to_string(i);
+        map[key] = std::to_string(i);
+        reference[key] = std::to_string(i);
+    }
+    ASSERT_EQ(map.size(), reference.size());
+    for (const auto& [key, value] : reference) {
+        const std::string* found = map.find(key);
+        ASSERT_NE(found, nullptr) << key;
+        EXPECT_EQ(*found, value);
+    }
+    EXPECT_EQ(map.find("section_1.item_999999"), nullptr);
+}
+
+TEST(FlatStringMap, ShrinkToFitKeepsContents) {
+    FlatStringMap<std::string> map;
+    for (int i = 0; i < 1000; ++i) {
+        map["k" + std::to_string(i)] = "v" + std::to_string(i);
+    }
+    size_t before = map.memoryUsage();
+    map.shrinkToFit();
+    EXPECT_LE(map.memoryUsage(), before);
+    for (int i = 0; i < 1000; ++i) {
+        const std::string* found = map.find("k" + std::to_string(i));
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(*found, "v" + std::to_string(i));
+    }
+    // Still insertable after shrinking
+    map["extra"] = "x";
+    EXPECT_EQ(*map.find("extra"), "x");
+}
+
+TEST(FlatStringMap, ClearKeepsTableUsable) {
+    FlatStringMap<std::string> map;
+    for (int i = 0; i < 100; ++i) {
+        map["k" + std::to_string(i)] = "v";
+    }
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find("k1"), nullptr);
+    map["k1"] = "again";
+    EXPECT_EQ(*map.find("k1"), "again");
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(FlatStringMap, EmptyKeyIsAValidKey) {
+    FlatStringMap<std::string> map;
+    map[""] = "empty";
+    ASSERT_NE(map.find(""), nullptr);
+    EXPECT_EQ(*map.find(""), "empty");
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <string>
+
+using i18n::KeyFilter;
+using Map = i18n::FlatStringMap<int>;
+
+TEST(KeyFilterTest, EmptyFilterRejectsEverything) {
+    KeyFilter filter;
+    EXPECT_FALSE(filter.mayContain(Map::hashOf("greeting")));
+    filter.reset(0);
+    EXPECT_FALSE(filter.mayContain(Map::hashOf("greeting")));
+}
+
+TEST(KeyFilterTest, NoFalseNegatives) {
+    const size_t count = 20000;
+    KeyFilter filter;
+    filter.reset(count);
+    for (size_t i = 0; i < count; ++i) {
+        filter.insert(Map::hashOf("section." + std::to_string(i)));
+    }
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_TRUE(filter.mayContain(Map::hashOf("section." + std::to_string(i)))) << i;
+    }
+}
+
+TEST(KeyFilterTest, FalsePositiveRateIsLow) {
+    const size_t count = 20000;
+    KeyFilter filter;
+    filter.reset(count);
+    for (size_t i = 0; i < count; ++i) {
+        filter.insert(Map::hashOf("section." + std::to_string(i)));
+    }
+    size_t falsePositives = 0;
+    for (size_t i = 0; i < count; ++i) {
+        falsePositives += filter.mayContain(Map::hashOf("section." + std::to_string(i) + ".other"));
+    }
+    EXPECT_LT(falsePositives, count / 50); // < 2%
+}
+
+TEST(KeyFilterTest, SizedAtAboutTwoBytesPerKey) {
+    KeyFilter filter;
+    filter.reset(1000);
+    EXPECT_GE(filter.memoryUsage(), 2000u);
+    EXPECT_LE(filter.memoryUsage(), 4096u);
+}
+
+TEST(KeyFilterTest, CatalogLookupsStillResolve) {
+    i18n::I18N i18n;
+    i18n.load({
+        {"en", {{"greeting", "Hello"}, {"apples", {{"one", "{0} apple"}, {"other", "{0} apples"}}}}},
+        {"de", {{"greeting", "Hallo"}}}
+    });
+    i18n.setLocale("de");
+    i18n.setFallbackLocale("en");
+    EXPECT_EQ(i18n.tr("greeting"), "Hallo");
+    EXPECT_EQ(i18n.tr("missing"), "missing");
+    EXPECT_EQ(i18n.trPlural("apples", 1), "1 apple");
+    EXPECT_EQ(i18n.trPlural("apples", 7), "7 apples");
+    EXPECT_FALSE(i18n.keyExists("apples.few"));
+
+    // Keys loaded later are added to the filter
+    i18n.load({{"fr", {{"late", "Tard"}}}});
+    i18n.setFallbackLocale("fr");
+    EXPECT_TRUE(i18n.keyExists("late"));
+    EXPECT_EQ(i18n.tr("late"), "Tard");
+
+    i18n.reset();
+    EXPECT_FALSE(i18n.keyExists("greeting"));
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+static std::string fixturesDir() {
+    return FIXTURES_DIR;
+}
+
+class KeyTrieTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.load({
+            {"en", {
+                {"settings", {
+                    {"title", "Settings"},
+                    {"privacy", {{"title", "Privacy"}, {"tracking", "Allow tracking"}, {"cookies", "Cookies"}}},
+                    {"privacy_policy", "Privacy policy"},
+                    {"privacy-legacy", "Legacy privacy"}
+                }},
+                {"apples", {{"one", "{0} apple"}, {"other", "{0} apples"}}},
+                {"greeting", "Hello {0}"}
+            }},
+            {"de", {
+                {"settings", {{"privacy", {{"title", "Datenschutz"}}}}},
+                {"only_de", "Nur Deutsch"}
+            }}
+        });
+        i18n.setLocale("de");
+        i18n.setFallbackLocale("en");
+    }
+
+    std::vector<std::string> keysUnder(std::string_view prefix) {
+        std::vector<std::string> keys;
+        i18n.forEachKeyWithPrefix(prefix, [&](std::string_view key) { keys.emplace_back(key); });
+        return keys;
+    }
+};
+
+TEST_F(KeyTrieTest, EnumeratesSubtreeInKeyOrder) {
+    EXPECT_EQ(keysUnder("settings.privacy"),
+              (std::vector<std::string>{"settings.privacy.cookies", "settings.privacy.title",
+                                        "settings.privacy.tracking"}));
+}
+
+TEST_F(KeyTrieTest, PrefixMatchesWholeSegmentsOnly) {
+    auto keys = keysUnder("settings");
+    EXPECT_EQ(keys, (std::vector<std::string>{
+        "settings.privacy.cookies", "settings.privacy.title", "settings.privacy.tracking",
+        "settings.privacy-legacy", "settings.privacy_policy", "settings.title"}));
+    EXPECT_TRUE(keysUnder("settings.priv").empty());
+    EXPECT_TRUE(keysUnder("nope").empty());
+}
+
+TEST_F(KeyTrieTest, PrefixMayNameALeafOrEndWithDot) {
+    EXPECT_EQ(keysUnder("settings.title"), (std::vector<std::string>{"settings.title"}));
+    EXPECT_EQ(keysUnder("apples."), (std::vector<std::string>{"apples.one", "apples.other"}));
+}
+
+TEST_F(KeyTrieTest, EmptyPrefixVisitsEveryTranslatedKey) {
+    // "apples" itself is interned for its .other form but has no value
+    EXPECT_EQ(keysUnder("").size(), 10u);
+}
+
+TEST_F(KeyTrieTest, TrSubtreeResolvesThroughChain) {
+    auto section = i18n.trSubtree("settings.privacy");
+    ASSERT_EQ(section.size(), 3u);
+    EXPECT_EQ(section[0], (std::pair<std::string, std::string>{"settings.privacy.cookies", "Cookies"}));
+    EXPECT_EQ(section[1], (std::pair<std::string, std::string>{"settings.privacy.title", "Datenschutz"}));
+    EXPECT_EQ(section[2], (std::pair<std::string, std::string>{"settings.privacy.tracking", "Allow tracking"}));
+}
+
+TEST_F(KeyTrieTest, TrSubtreeOmitsKeysOutsideChain) {
+    i18n.setLocale("en");
+    i18n.setFallbackLocale("en");
+    EXPECT_TRUE(i18n.trSubtree("only_de").empty());
+    auto all = i18n.trSubtree("");
+    EXPECT_EQ(all.size(), 9u);
+}
+
+TEST_F(KeyTrieTest, RebuiltAfterLoadAndMerge) {
+    i18n.load({{"fr", {{"settings", {{"privacy", {{"ads", "Publicité"}}}}}}}});
+    EXPECT_EQ(keysUnder("settings.privacy").front(), "settings.privacy.ads");
+
+    // Replacing de drops only_de from the catalog
+    i18n.load({{"de", {{"greeting", "Hallo {0}"}}}});
+    EXPECT_TRUE(keysUnder("only_de").empty());
+
+    i18n.mergeLocale("en", fixturesDir() + "/en.json");
+    EXPECT_FALSE(keysUnder("menu.file").empty());
+}
+
+TEST_F(KeyTrieTest, EmptyCatalog) {
+    i18n.reset();
+    EXPECT_TRUE(keysUnder("").empty());
+    EXPECT_TRUE(i18n.trSubtree("settings").empty());
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+class ListDurationTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.load(nlohmann::json::parse(R"json({
+            "en": {"title": "Feed"},
+            "de": {
+                "_formats": {
+                    "list": {"pair": "{0} und {1}", "end": "{0} und {1}"},
+                    "duration": {
+                        "separator": ", ",
+                        "units": {
+                            "hour": {"one": "{0} Stunde", "other": "{0} Stunden"},
+                            "minute": {"one": "{0} Minute", "other": "{0} Minuten"}
+                        }
+                    }
+                }
+            },
+            "ja": {
+                "_formats": {
+                    "list": {"pair": "{0}、{1}", "start": "{0}、{1}", "middle": "{0}、{1}", "end": "{0}、{1}"}
+                }
+            },
+            "xx": {
+                "_formats": {
+                    "list": {"start": "[{0}: {1}]", "middle": "<{0}; {1}>", "end": "({0} & {1})"}
+                }
+            }
+        })json"));
+        i18n.setLocale("en");
+    }
+
+    static std::vector<std::string_view> items(std::initializer_list<std::string_view> list) {
+        return list;
+    }
+};
+
+TEST_F(ListDurationTest, ListUsesPairStartMiddleEnd) {
+    EXPECT_EQ(i18n.formatList({}), "");
+    EXPECT_EQ(i18n.formatList(items({"A"})), "A");
+    EXPECT_EQ(i18n.formatList(items({"A", "B"})), "A and B");
+    EXPECT_EQ(i18n.formatList(items({"A", "B", "C"})), "A, B, and C");
+    EXPECT_EQ(i18n.formatList(items({"A", "B", "C", "D"})), "A, B, C, and D");
+}
+
+TEST_F(ListDurationTest, ListFollowsLocale) {
+    i18n.setLocale("de");
+    EXPECT_EQ(i18n.formatList(items({"A", "B", "C"})), "A, B und C");
+    i18n.setLocale("ja");
+    EXPECT_EQ(i18n.formatList(items({"A", "B", "C"})), "A、B、C");
+}
+
+TEST_F(ListDurationTest, ListNestsTrailingLiterals) {
+    i18n.setLocale("xx");
+    EXPECT_EQ(i18n.formatList(items({"A", "B", "C", "D", "E"})), "[A: <B; <C; (D & E)>>]");
+}
+
+TEST_F(ListDurationTest, ListIntoReservesExactly) {
+    std::string out = "> ";
+    out.shrink_to_fit();
+    i18n.formatListInto(out, items({"alpha", "beta", "gamma"}));
+    EXPECT_EQ(out, "> alpha, beta, and gamma");
+}
+
+TEST_F(ListDurationTest, InvalidListPatternThrows) {
+    EXPECT_THROW(i18n.configure(nlohmann::json::parse(R"({"list": {"pair": "{1} then {0}"}})")), i18n::I18NError);
+    EXPECT_THROW(i18n.configure(nlohmann::json::parse(R"({"list": {"end": "{0} only"}})")), i18n::I18NError);
+    EXPECT_EQ(i18n.formatList(items({"A", "B"})), "A and B");
+}
+
+TEST_F(ListDurationTest, DurationShowsNonzeroUnits) {
+    EXPECT_EQ(i18n.formatDuration(0s), "0 s");
+    EXPECT_EQ(i18n.formatDuration(45s), "45 s");
+    EXPECT_EQ(i18n.formatDuration(2h + 15min), "2 h 15 min");
+    EXPECT_EQ(i18n.formatDuration(std::chrono::hours(26) + 5s), "1 d 2 h 5 s");
+    EXPECT_EQ(i18n.formatDuration(-(90s)), "-1 min 30 s");
+}
+
+TEST_F(ListDurationTest, DurationUsesPluralTemplates) {
+    i18n.setLocale("de");
+    EXPECT_EQ(i18n.formatDuration(1h + 1min), "1 Stunde, 1 Minute");
+    EXPECT_EQ(i18n.formatDuration(2h + 15min), "2 Stunden, 15 Minuten");
+    EXPECT_EQ(i18n.formatDuration(2h + 15min + 30s), "2 Stunden, 15 Minuten, 30 s");
+}
+
+TEST_F(ListDurationTest, DurationPartialUnitTable) {
+    i18n.load(nlohmann::json::parse(R"json({
+        "cs": {
+            "_formats": {
+                "duration": {
+                    "separator": ", ",
+                    "units": {
+                        "day": {},
+                        "hour": {"one": "{0} hodina"},
+                        "minute": {"few": "{0} minuty", "other": "{0} minut"}
+                    }
+                }
+            }
+        }
+    })json"));
+    i18n.setLocale("cs");
+    EXPECT_EQ(i18n.formatDuration(std::chrono::hours(25) + 3min), "1, 1 hodina, 3 minuty");
+    EXPECT_EQ(i18n.formatDuration(2h + 5min + 2s), "2, 5 minut, 2 s");
+}
+
+TEST_F(ListDurationTest, DurationMaxUnitsTruncates) {
+    i18n.configure(nlohmann::json::parse(R"({"duration": {"max_units": 2}})"));
+    EXPECT_EQ(i18n.formatDuration(2h + 15min + 30s), "2 h 15 min");
+    EXPECT_EQ(i18n.formatDuration(std::chrono::hours(24) + 30s), "1 d 30 s");
+}
+
+TEST_F(ListDurationTest, ResetDropsCompiledFormatters) {
+    i18n.setLocale("de");
+    EXPECT_EQ(i18n.formatList(items({"a", "b"})), "a und b");
+    EXPECT_EQ(i18n.formatDuration(3660s), "1 Stunde, 1 Minute");
+    i18n.reset();
+    const i18n::I18N fresh;
+    EXPECT_EQ(i18n.formatList(items({"a", "b"})), fresh.formatList(items({"a", "b"})));
+    EXPECT_EQ(i18n.formatDuration(3660s), fresh.formatDuration(3660s));
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <string>
+#include <vector>
+
+class MaterializeTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.load({
+            {"en", {
+                {"greeting", "Hello"},
+                {"farewell", "Goodbye"},
+                {"only_en", "English only"},
+                {"apples", {{"one", "{0} apple"}, {"other", "{0} apples"}}}
+            }},
+            {"de", {
+                {"greeting", "Hallo"},
+                {"apples", {{"other", "{0} Äpfel"}}}
+            }},
+            {"de-AT", {
+                {"greeting", "Servus"}
+            }}
+        });
+        i18n.setLocale("de-AT");
+        i18n.setFallbackLocale("en");
+    }
+
+    std::vector<std::string> snapshot() {
+        i18n.setLocale("de-AT"); // drops the translation cache
+        return {
+            i18n.tr("greeting"), i18n.tr("farewell"), i18n.tr("only_en"),
+            i18n.tr("apples", {"2"}), i18n.tr("apples.one", {"1"}), i18n.tr("missing"),
+            i18n.keyExists("apples") ? "yes" : "no", i18n.keyExists("missing") ? "yes" : "no",
+        };
+    }
+};
+
+TEST_F(MaterializeTest, SameResultsAsChainWalk) {
+    std::vector<std::string> walked = snapshot();
+    i18n.materializeFallbacks();
+    EXPECT_EQ(snapshot(), walked);
+    EXPECT_EQ(i18n.tr("greeting"), "Servus");
+    EXPECT_EQ(i18n.tr("apples", {"2"}), "2 Äpfel");
+}
+
+TEST_F(MaterializeTest, ReportsMemoryCost) {
+    EXPECT_EQ(i18n.materializedMemoryUsage(), 0u);
+    size_t bytes = i18n.materializeFallbacks();
+    // One pointer per interned key (the six translated keys plus "apples")
+    EXPECT_GE(bytes, 7 * sizeof(const std::string*));
+    EXPECT_EQ(bytes, i18n.materializedMemoryUsage());
+}
+
+TEST_F(MaterializeTest, LocaleSwitchMaterializesNewChain) {
+    size_t first = i18n.materializeFallbacks();
+    i18n.setLocale("en");
+    EXPECT_EQ(i18n.tr("greeting"), "Hello");
+    EXPECT_EQ(i18n.tr("apples", {"2"}), "2 apples");
+    EXPECT_GT(i18n.materializedMemoryUsage(), first);
+
+    // Switching back reuses the first table
+    size_t both = i18n.materializedMemoryUsage();
+    i18n.setLocale("de-AT");
+    EXPECT_EQ(i18n.tr("greeting"), "Servus");
+    EXPECT_EQ(i18n.materializedMemoryUsage(), both);
+}
+
+TEST_F(MaterializeTest, LoadingDataRebuildsTables) {
+    i18n.materializeFallbacks();
+    i18n.setLocale("en");
+    i18n.load({{"de-AT", {{"greeting", "Griaß di"}, {"farewell", "Pfiat di"}}}});
+    i18n.setLocale("de-AT");
+    EXPECT_EQ(i18n.tr("greeting"), "Griaß di");
+    EXPECT_EQ(i18n.tr("farewell"), "Pfiat di");
+    EXPECT_EQ(i18n.tr("apples", {"3"}), "3 Äpfel");
+
+    i18n.load({{"fr", {{"new_key", "Nouveau"}}}});
+    EXPECT_EQ(i18n.tr("new_key"), "new_key");
+    i18n.setFallbackLocale("fr");
+    EXPECT_EQ(i18n.tr("new_key"), "Nouveau");
+}
+
+TEST_F(MaterializeTest, BatchUsesMaterializedTable) {
+    i18n.materializeFallbacks();
+    std::vector<i18n::KeyRequest> requests = {{"greeting"}, {"only_en"}, {"missing"}};
+    i18n::BatchOutput out;
+    i18n.trBatch(requests, out);
+    EXPECT_EQ(out[0], "Servus");
+    EXPECT_EQ(out[1], "English only");
+    EXPECT_EQ(out[2], "missing");
+}
+
+TEST_F(MaterializeTest, TrPluralUnaffected) {
+    i18n.materializeFallbacks();
+    EXPECT_EQ(i18n.trPlural("apples", 1), "1 Äpfel");
+    i18n.setLocale("en");
+    EXPECT_EQ(i18n.trPlural("apples", 1), "1 apple");
+}
+
+TEST_F(MaterializeTest, ResetDropsTables) {
+    i18n.materializeFallbacks();
+    i18n.reset();
+    EXPECT_EQ(i18n.materializedMemoryUsage(), 0u);
+    i18n.load({{"en", {{"greeting", "Hello"}}}});
+    i18n.setLocale("en");
+    EXPECT_EQ(i18n.tr("greeting"), "Hello");
+    EXPECT_EQ(i18n.materializedMemoryUsage(), 0u);
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <iterator>
+#include <string>
+
+#if defined(I18N_HAS_STD_FORMATTER)
+namespace test_fmt { using std::format; using std::format_to; }
+#elif defined(I18N_HAS_FMT_FORMATTER)
+namespace test_fmt { using fmt::format; using fmt::format_to; }
+#endif
+
+#if defined(I18N_HAS_STD_FORMATTER) || defined(I18N_HAS_FMT_FORMATTER)
+
+class MessageFormatTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.load({
+            {"en", {
+                {"status", "{0} new messages"},
+                {"title", "Settings"}
+            }}
+        });
+        i18n.setLocale("en");
+    }
+};
+
+TEST_F(MessageFormatTest, FormatsLikeTrf) {
+    EXPECT_EQ(test_fmt::format("{}: {}", "Inbox", i18n.msg("status", 3)), "Inbox: 3 new messages");
+    EXPECT_EQ(test_fmt::format("[{}]", i18n.msg("title")), "[Settings]");
+}
+
+TEST_F(MessageFormatTest, FormatsIntoExistingBuffer) {
+    std::string out = "> ";
+    test_fmt::format_to(std::back_inserter(out), "{} | {}", i18n.msg("title"), i18n.msg("status", 12));
+    EXPECT_EQ(out, "> Settings | 12 new messages");
+}
+
+TEST_F(MessageFormatTest, AppliesStringSpec) {
+    EXPECT_EQ(test_fmt::format("[{:>10}]", i18n.msg("title")), "[  Settings]");
+    EXPECT_EQ(test_fmt::format("[{:*<10}]", i18n.msg("title")), "[Settings**]");
+    EXPECT_EQ(test_fmt::format("[{:.3}]", i18n.msg("title")), "[Set]");
+}
+
+TEST_F(MessageFormatTest, MissingKeyFormatsKey) {
+    EXPECT_EQ(test_fmt::format("{}", i18n.msg("no.such.key")), "no.such.key");
+}
+
+#endif
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+class MessageRefsTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.load({
+            {"en", {
+                {"common", {{"app_name", "Acme"}, {"team", "the @:common.app_name team"}}},
+                {"welcome", "Welcome to @:common.app_name."},
+                {"signature", "Regards, $t(common.team)"},
+                {"about", "About @:common.app_name, {0}"}
+            }},
+            {"en-GB", {
+                {"common", {{"app_name", "Acme Ltd"}}},
+                {"goodbye", "Goodbye from @:common.app_name and $t(signature)"}
+            }}
+        });
+        i18n.setLocale("en");
+    }
+};
+
+TEST_F(MessageRefsTest, ReferencesAreInlined) {
+    EXPECT_EQ(i18n.tr("welcome"), "Welcome to Acme.");
+    EXPECT_EQ(i18n.tr("about", {"Bob"}), "About Acme, Bob");
+}
+
+TEST_F(MessageRefsTest, NestedReferencesResolve) {
+    EXPECT_EQ(i18n.tr("common.team"), "the Acme team");
+    EXPECT_EQ(i18n.tr("signature"), "Regards, the Acme team");
+}
+
+TEST_F(MessageRefsTest, RegionalLocaleReadsOwnValueThenAncestor) {
+    i18n.setLocale("en-GB");
+    EXPECT_EQ(i18n.tr("goodbye"), "Goodbye from Acme Ltd and Regards, the Acme team");
+    // Inherited messages keep the text resolved in their own locale
+    EXPECT_EQ(i18n.tr("welcome"), "Welcome to Acme.");
+}
+
+TEST_F(MessageRefsTest, UnknownReferenceIsKeptVerbatim) {
+    i18n.load({{"en", {{"broken", "See @:nowhere and $t(missing.key)"}}}});
+    EXPECT_EQ(i18n.tr("broken"), "See @:nowhere and $t(missing.key)");
+}
+
+TEST_F(MessageRefsTest, ReloadingTargetReexpandsDependents) {
+    // en-GB's goodbye references en's signature; reloading en re-expands it
+    i18n.load({{"en", {{"common", {{"app_name", "Globex"}, {"team", "the @:common.app_name team"}}},
+                       {"signature", "Regards, $t(common.team)"}}}});
+    i18n.setLocale("en-GB");
+    EXPECT_EQ(i18n.tr("goodbye"), "Goodbye from Acme Ltd and Regards, the Globex team");
+}
+
+TEST_F(MessageRefsTest, OverwritingWithPlainTextDropsTheSource) {
+    i18n.load({{"en", {{"common", {{"app_name", "Acme"}, {"team", "staff"}}},
+                       {"signature", "Regards, $t(common.team)"}}}});
+    EXPECT_EQ(i18n.tr("signature"), "Regards, staff");
+}
+
+TEST_F(MessageRefsTest, CycleThrowsAndUndoesTheLoad) {
+    i18n::I18N inst;
+    try {
+        inst.load({{"en", {{"a", "A(@:b)"}, {"b", "B($t(a))"}, {"c", "C"}}}});
+        FAIL() << "expected I18NError";
+    } catch (const i18n::I18NError& e) {
+        EXPECT_NE(std::string(e.what()).find("Circular message reference"), std::string::npos);
+    }
+    inst.setLocale("en");
+    EXPECT_EQ(inst.tr("a"), "a");
+    EXPECT_EQ(inst.tr("c"), "c");
+}
+
+TEST_F(MessageRefsTest, CyclicLoadKeepsThePreviousCatalog) {
+    // Every locale of the load is undone, as are the formats it configured
+    // and the descendants (en-GB) it re-expanded
+    EXPECT_THROW(i18n.load({
+        {"en", {{"_formats", {{"list", {{"pair", "{0} + {1}"}}}}},
+                {"common", {{"app_name", "Globex"}, {"team", "the @:team.name team"}}},
+                {"team", {{"name", "@:common.team"}}}}},
+        {"fr", {{"bonjour", "Bonjour"}}}
+    }), i18n::I18NError);
+    EXPECT_EQ(i18n.tr("welcome"), "Welcome to Acme.");
+    EXPECT_EQ(i18n.tr("signature"), "Regards, the Acme team");
+    EXPECT_EQ(i18n.tr("team.name"), "team.name");
+    const std::vector<std::string_view> items{"a", "b"};
+    EXPECT_EQ(i18n.formatList(items), i18n::I18N().formatList(items));
+    i18n.setLocale("en-GB");
+    EXPECT_EQ(i18n.tr("goodbye"), "Goodbye from Acme Ltd and Regards, the Acme team");
+    i18n.setLocale("fr");
+    EXPECT_EQ(i18n.tr("bonjour"), "bonjour");
+}
+
+TEST_F(MessageRefsTest, SelfReferenceIsACycle) {
+    i18n::I18N inst;
+    EXPECT_THROW(inst.load({{"en", {{"self", "x @:self"}}}}), i18n::I18NError);
+}
+
+TEST_F(MessageRefsTest, LoadsAfterARejectedCycleSucceed) {
+    i18n::I18N inst;
+    EXPECT_THROW(inst.load({{"en", {{"a", "@:b"}, {"b", "@:a"}}}}), i18n::I18NError);
+    EXPECT_NO_THROW(inst.load({{"de", {{"x", "Hallo @:y"}, {"y", "Welt"}}}}));
+    inst.setLocale("de");
+    EXPECT_EQ(inst.tr("x"), "Hallo Welt");
+    EXPECT_NO_THROW(inst.load({{"en", {{"a", "@:b"}, {"b", "B"}}}}));
+    inst.setLocale("en");
+    EXPECT_EQ(inst.tr("a"), "B");
+}
+
+TEST_F(MessageRefsTest, DependentsSurviveRepeatedReexpansion) {
+    for (const char* name : {"Globex", "Initech", "Umbrella"}) {
+        i18n.load({{"en", {{"common", {{"app_name", name}, {"team", "the @:common.app_name team"}}},
+                           {"signature", "Regards, $t(common.team)"}}}});
+    }
+    i18n.setLocale("en-GB");
+    EXPECT_EQ(i18n.tr("goodbye"), "Goodbye from Acme Ltd and Regards, the Umbrella team");
+}
+
+TEST_F(MessageRefsTest, LongReferenceChainDoesNotRecurse) {
+    constexpr int kLength = 200000;
+    i18n::json catalog = i18n::json::object();
+    for (int i = 0; i < kLength; ++i) {
+        catalog["k" + std::to_string(i)] = "@:k" + std::to_string(i + 1);
+    }
+    catalog["k" + std::to_string(kLength)] = "end";
+    i18n::I18N inst;
+    inst.load({{"en", catalog}});
+    inst.setLocale("en");
+    EXPECT_EQ(inst.tr("k0"), "end");
+}
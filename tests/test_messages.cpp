@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <sstream>
+#include <string>
+
+using i18n::Escape;
+
+class MessageTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.load({
+            {"en", {
+                {"welcome", "Welcome back, {0}! You have {1} new messages."},
+                {"title", "Settings"},
+                {"html", "<b>{0}</b>"}
+            }},
+            {"de", {
+                {"welcome", "Willkommen zurück, {0}! Du hast {1} neue Nachrichten."}
+            }}
+        });
+        i18n.setLocale("en");
+    }
+};
+
+TEST_F(MessageTest, RendersLikeTrf) {
+    const std::string name = "Ann";
+    auto message = i18n.msg("welcome", name, 3);
+    EXPECT_EQ(message.str(), i18n.trf("welcome", {name, 3}));
+    EXPECT_EQ(std::string(message), message.str());
+    EXPECT_EQ(i18n.msg("title").str(), "Settings");
+}
+
+TEST_F(MessageTest, StreamsSegments) {
+    std::ostringstream os;
+    os << i18n.msg("welcome", "Bo", 1) << " | " << i18n.msg("title");
+    EXPECT_EQ(os.str(), "Welcome back, Bo! You have 1 new messages. | Settings");
+}
+
+TEST_F(MessageTest, AppendsToBuffers) {
+    std::string out = "> ";
+    i18n.msg("html", "a&b").appendTo(out, Escape::Html);
+    EXPECT_EQ(out, "> &lt;b&gt;a&amp;b&lt;/b&gt;");
+
+    i18n::SegmentedOutput segments;
+    i18n.msg("welcome", "Cy", 2).appendTo(segments);
+    EXPECT_EQ(segments.str(), "Welcome back, Cy! You have 2 new messages.");
+}
+
+TEST_F(MessageTest, RendersWithLocaleAtTheSink) {
+    auto message = i18n.msg("welcome", "Ann", 3);
+    i18n.setLocale("de");
+    EXPECT_EQ(message.str(), "Willkommen zurück, Ann! Du hast 3 neue Nachrichten.");
+}
+
+TEST_F(MessageTest, MissingKeyRendersKey) {
+    EXPECT_EQ(i18n.msg("no.such.key", 1).str(), "no.such.key");
+}
+
+TEST_F(MessageTest, CapturesKeyAndArgs) {
+    auto message = i18n.msg("welcome", "Ann", 3);
+    EXPECT_EQ(message.key(), "welcome");
+    ASSERT_EQ(message.args().size(), 2u);
+    EXPECT_EQ(message.args()[0].text(), "Ann");
+    EXPECT_EQ(message.args()[1].integer(), 3);
+}
+
+TEST_F(MessageTest, AppendToSegmentsKeepsEarlierMessages) {
+    const std::string who = "Dee";
+    i18n::SegmentedOutput segments;
+    i18n.msg("welcome", who, 5).appendTo(segments);
+    i18n.msg("no.such.key").appendTo(segments);
+    i18n.msg("welcome", who, 6).appendTo(segments);
+    EXPECT_EQ(segments.str(), "Welcome back, Dee! You have 5 new messages.no.such.key"
+                              "Welcome back, Dee! You have 6 new messages.");
+
+    // trfSegments() still replaces
+    i18n.trfSegments(segments, "title", {});
+    EXPECT_EQ(segments.str(), "Settings");
+}
+
+TEST_F(MessageTest, StreamingDoesNotAccumulate) {
+    std::ostringstream first;
+    first << i18n.msg("title");
+    std::ostringstream second;
+    second << i18n.msg("title");
+    EXPECT_EQ(second.str(), "Settings");
+}
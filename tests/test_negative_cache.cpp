@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <string>
+
+class NegativeCacheTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.load({
+            {"en", {{"greeting", "Hello"}}},
+            {"de", {{"greeting", "Hallo"}}}
+        });
+        i18n.setLocale("de");
+        i18n.setFallbackLocale("en");
+    }
+};
+
+TEST_F(NegativeCacheTest, TrMissIsCached) {
+    EXPECT_EQ(i18n.tr("rollout.new_banner"), "rollout.new_banner");
+    const size_t size = i18n.translationCacheSize();
+    EXPECT_EQ(size, 1u);
+    EXPECT_EQ(i18n.tr("rollout.new_banner"), "rollout.new_banner");
+    EXPECT_EQ(i18n.translationCacheSize(), size);
+}
+
+TEST_F(NegativeCacheTest, MissWithParamsReturnsKeyUninterpolated) {
+    EXPECT_EQ(i18n.tr("rollout.{0}", {"x"}), "rollout.{0}");
+    EXPECT_EQ(i18n.tr("rollout.{0}", {"x"}), "rollout.{0}");
+}
+
+TEST_F(NegativeCacheTest, TrPluralMissIsCached) {
+    EXPECT_EQ(i18n.trPlural("rollout.items", 4), "rollout.items");
+    EXPECT_EQ(i18n.translationCacheSize(), 1u);
+    EXPECT_EQ(i18n.trPlural("rollout.items", 4), "rollout.items");
+    EXPECT_EQ(i18n.translationCacheSize(), 1u);
+}
+
+TEST_F(NegativeCacheTest, LoadingTheKeyInvalidatesMiss) {
+    EXPECT_EQ(i18n.tr("rollout.new_banner"), "rollout.new_banner");
+    EXPECT_EQ(i18n.trPlural("rollout.items", 4), "rollout.items");
+    i18n.load({{"en", {
+        {"greeting", "Hello"},
+        {"rollout", {{"new_banner", "New!"}, {"items", {{"one", "{0} item"}, {"other", "{0} items"}}}}}
+    }}});
+    EXPECT_EQ(i18n.tr("rollout.new_banner"), "New!");
+    EXPECT_EQ(i18n.trPlural("rollout.items", 4), "4 items");
+}
+
+TEST_F(NegativeCacheTest, LocaleChangeInvalidatesMiss) {
+    i18n.load({{"fr", {{"only_fr", "Seulement"}}}});
+    EXPECT_EQ(i18n.tr("only_fr"), "only_fr");
+    i18n.setLocale("fr");
+    EXPECT_EQ(i18n.tr("only_fr"), "Seulement");
+}
+
+TEST_F(NegativeCacheTest, MissesAreBounded) {
+    for (int i = 0; i < 5000; ++i) {
+        const std::string key = "rollout.key_" + std::to_string(i);
+        EXPECT_EQ(i18n.tr(key), key);
+        EXPECT_EQ(i18n.trPlural(key, i), key);
+    }
+    EXPECT_LE(i18n.translationCacheSize(), 1024u);
+    EXPECT_EQ(i18n.tr("greeting"), "Hallo");
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+class OrdinalTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.load(nlohmann::json::parse(R"json({
+            "en": {
+                "place": {"one": "{0}st place", "two": "{0}nd place", "few": "{0}rd place", "other": "{0}th place"},
+                "floor": {"one": "{0}st floor of {1}", "other": "{0}th floor of {1}"},
+                "lap": {"few": "lap {0}", "1": "first lap"},
+                "items": {"one": "{0} item", "other": "{0} items"}
+            },
+            "fr": {
+                "_formats": {"ordinal": {"one": "{0}er", "other": "{0}e"}},
+                "place": {"one": "{0}re place", "other": "{0}e place"}
+            },
+            "it": {
+                "_formats": {"ordinal": {"many": "l'{0}°", "other": "il {0}°"}}
+            },
+            "sv": {
+                "_formats": {"ordinal": {"one": "{0}:a", "other": "{0}:e"}}
+            },
+            "de": {
+                "_formats": {"ordinal": {"other": "{0}."}}
+            }
+        })json"));
+        i18n.setLocale("en");
+    }
+};
+
+TEST_F(OrdinalTest, EnglishCategories) {
+    EXPECT_EQ(i18n.trOrdinal("place", 1), "1st place");
+    EXPECT_EQ(i18n.trOrdinal("place", 2), "2nd place");
+    EXPECT_EQ(i18n.trOrdinal("place", 3), "3rd place");
+    EXPECT_EQ(i18n.trOrdinal("place", 4), "4th place");
+    EXPECT_EQ(i18n.trOrdinal("place", 11), "11th place");
+    EXPECT_EQ(i18n.trOrdinal("place", 12), "12th place");
+    EXPECT_EQ(i18n.trOrdinal("place", 13), "13th place");
+    EXPECT_EQ(i18n.trOrdinal("place", 21), "21st place");
+    EXPECT_EQ(i18n.trOrdinal("place", 102), "102nd place");
+    EXPECT_EQ(i18n.trOrdinal("place", 113), "113th place");
+}
+
+TEST_F(OrdinalTest, OrdinalAndCardinalFormsAreCachedSeparately) {
+    // Both pick a form for 2 from the same key: cardinal "other", ordinal "two"
+    EXPECT_EQ(i18n.trPlural("place", 2), "2th place");
+    EXPECT_EQ(i18n.trOrdinal("place", 2), "2nd place");
+    EXPECT_EQ(i18n.trPlural("place", 2), "2th place");
+    EXPECT_EQ(i18n.trPlural("items", 1), "1 item");
+    EXPECT_EQ(i18n.trOrdinal("items", 1), "1 item");
+    EXPECT_EQ(i18n.trOrdinal("items", 2), "2 items");
+}
+
+TEST_F(OrdinalTest, ParamsFollowTheCount) {
+    EXPECT_EQ(i18n.trOrdinal("floor", 1, {"Tower A"}), "1st floor of Tower A");
+    EXPECT_EQ(i18n.trOrdinal("floor", 2, {"Tower A"}), "2th floor of Tower A");
+    const std::string params[] = {"Tower B"};
+    EXPECT_EQ(i18n.trOrdinal("floor", 31, params), "31st floor of Tower B");
+}
+
+TEST_F(OrdinalTest, ExactCountFormsFillMissingCategories) {
+    EXPECT_EQ(i18n.trOrdinal("lap", 1), "first lap");
+    EXPECT_EQ(i18n.trOrdinal("lap", 3), "lap 3");
+    EXPECT_EQ(i18n.trOrdinal("lap", 4), "lap");
+    EXPECT_EQ(i18n.trOrdinal("lap", 1), "first lap");
+}
+
+TEST_F(OrdinalTest, MissingKeyReturnsKey) {
+    EXPECT_EQ(i18n.trOrdinal("nope", 3), "nope");
+    EXPECT_EQ(i18n.trOrdinal("", 3), "");
+}
+
+TEST_F(OrdinalTest, ChainUsesEachLocalesRules) {
+    i18n.setLocale("fr");
+    EXPECT_EQ(i18n.trOrdinal("place", 1), "1re place");
+    EXPECT_EQ(i18n.trOrdinal("place", 2), "2e place");
+    EXPECT_EQ(i18n.trOrdinal("place", 21), "21e place");
+
+    // "lap" is only in English: the fallback picks English's form for 3
+    i18n.setFallbackLocale("en");
+    EXPECT_EQ(i18n.trOrdinal("lap", 3), "lap 3");
+}
+
+TEST_F(OrdinalTest, FormatOrdinalEnglishDefaults) {
+    EXPECT_EQ(i18n.formatOrdinal(0), "0th");
+    EXPECT_EQ(i18n.formatOrdinal(1), "1st");
+    EXPECT_EQ(i18n.formatOrdinal(2), "2nd");
+    EXPECT_EQ(i18n.formatOrdinal(3), "3rd");
+    EXPECT_EQ(i18n.formatOrdinal(11), "11th");
+    EXPECT_EQ(i18n.formatOrdinal(111), "111th");
+    EXPECT_EQ(i18n.formatOrdinal(1001), "1001st");
+    EXPECT_EQ(i18n.formatOrdinal(-22), "-22nd");
+    EXPECT_EQ(i18n.formatOrdinal(std::numeric_limits<int64_t>::max()), "9223372036854775807th");
+    EXPECT_EQ(i18n.formatOrdinal(std::numeric_limits<int64_t>::min()), "-9223372036854775808th");
+}
+
+TEST_F(OrdinalTest, FormatOrdinalFollowsLocale) {
+    i18n.setLocale("fr");
+    EXPECT_EQ(i18n.formatOrdinal(1), "1er");
+    EXPECT_EQ(i18n.formatOrdinal(2), "2e");
+    EXPECT_EQ(i18n.formatOrdinal(21), "21e");
+
+    i18n.setLocale("it");
+    EXPECT_EQ(i18n.formatOrdinal(8), "l'8°");
+    EXPECT_EQ(i18n.formatOrdinal(11), "l'11°");
+    EXPECT_EQ(i18n.formatOrdinal(12), "il 12°");
+
+    i18n.setLocale("sv");
+    EXPECT_EQ(i18n.formatOrdinal(1), "1:a");
+    EXPECT_EQ(i18n.formatOrdinal(22), "22:a");
+    EXPECT_EQ(i18n.formatOrdinal(12), "12:e");
+    EXPECT_EQ(i18n.formatOrdinal(3), "3:e");
+
+    i18n.setLocale("de");
+    EXPECT_EQ(i18n.formatOrdinal(1), "1.");
+    EXPECT_EQ(i18n.formatOrdinal(3), "3.");
+
+    i18n.setLocale("en");
+    EXPECT_EQ(i18n.formatOrdinal(1), "1st");
+}
+
+TEST_F(OrdinalTest, ConfigureReplacesForms) {
+    i18n.configure({{"ordinal", {{"other", "#{0}"}}}});
+    EXPECT_EQ(i18n.formatOrdinal(1), "#1");
+    EXPECT_EQ(i18n.formatOrdinal(2), "#2");
+}
+
+TEST_F(OrdinalTest, OrdinalPlaceholder) {
+    i18n.load(nlohmann::json::parse(R"json({"en": {"finish": "{0} finished {1:ordinal}"}})json"));
+    EXPECT_EQ(i18n.trf("finish", {"Ana", 2}), "Ana finished 2nd");
+    EXPECT_EQ(i18n.trf("finish", {"Ana", 23.0}), "Ana finished 23rd");
+    EXPECT_EQ(i18n.trf("finish", {"Ana", "last"}), "Ana finished last");
+}
+
+TEST_F(OrdinalTest, FormatOrdinalIntoAppends) {
+    std::string out = "Rank: ";
+    i18n.formatOrdinalInto(out, 42);
+    EXPECT_EQ(out, "Rank: 42nd");
+}
+
+TEST_F(OrdinalTest, UnconfiguredLocaleWithOtherRulesUsesBareNumber) {
+    i18n.load({{"fr-CA", {{"title", "Titre"}}}, {"es", {{"title", "Título"}}}});
+    // fr-CA has no _formats.ordinal of its own and French ordinal rules
+    i18n.setLocale("fr-CA");
+    EXPECT_EQ(i18n.formatOrdinal(1), "1");
+    EXPECT_EQ(i18n.formatOrdinal(2), "2");
+    EXPECT_EQ(i18n.formatOrdinal(3), "3");
+    i18n.setLocale("es");
+    EXPECT_EQ(i18n.formatOrdinal(2), "2");
+}
+
+TEST_F(OrdinalTest, UnlistedLanguageHasASingleForm) {
+    i18n.load(nlohmann::json::parse(R"json({
+        "lt": {"place": {"one": "{0}-oji vieta", "other": "{0}-a vieta"}}
+    })json"));
+    i18n.setLocale("lt");
+    EXPECT_EQ(i18n.formatOrdinal(1), "1");
+    EXPECT_EQ(i18n.formatOrdinal(2), "2");
+    EXPECT_EQ(i18n.formatOrdinal(3), "3");
+    EXPECT_EQ(i18n.trOrdinal("place", 1), "1-a vieta");
+    EXPECT_EQ(i18n.trOrdinal("place", 21), "21-a vieta");
+}
+
+TEST_F(OrdinalTest, ResetDropsCompiledFormatter) {
+    i18n.setLocale("de");
+    EXPECT_EQ(i18n.formatOrdinal(2), "2.");
+    i18n.reset();
+    EXPECT_EQ(i18n.formatOrdinal(2), "2nd");
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+static std::string fixturesDir() {
+    return FIXTURES_DIR;
+}
+
+class ParamViewsTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.loadLocale("en", (fixturesDir() + "/en.json").c_str());
+        i18n.setLocale("en");
+        i18n.setFallbackLocale("en");
+    }
+};
+
+TEST_F(ParamViewsTest, InitializerListOfLiterals) {
+    EXPECT_EQ(i18n.tr("welcome_pos", {"Alice", "Wonderland"}), "Hello Alice, welcome to Wonderland");
+    EXPECT_EQ(i18n.trPlural("items_in_cart", 3, {"cart"}), "3 items in cart");
+}
+
+TEST_F(ParamViewsTest, InitializerListMixesStringsAndViews) {
+    std::string name = "Alice";
+    std::string_view place = "Wonderland";
+    EXPECT_EQ(i18n.tr("welcome_pos", {name, place}), "Hello Alice, welcome to Wonderland");
+}
+
+TEST_F(ParamViewsTest, StringViewSpan) {
+    std::vector<std::string_view> params = {"Alice", "Wonderland"};
+    EXPECT_EQ(i18n.tr("welcome_pos", params), "Hello Alice, welcome to Wonderland");
+    EXPECT_EQ(i18n.tr("welcome_unnamed", params), "Hello Alice, welcome to Wonderland");
+
+    std::vector<std::string_view> cart = {"basket"};
+    EXPECT_EQ(i18n.trPlural("items_in_cart", 1, cart), "1 item in basket");
+}
+
+TEST_F(ParamViewsTest, ViewsIntoLargerBufferAreNotOverread) {
+    const std::string buffer = "AliceWonderland";
+    const std::string_view params[] = {std::string_view(buffer).substr(0, 5), std::string_view(buffer).substr(5)};
+    EXPECT_EQ(i18n.tr("welcome_pos", params), "Hello Alice, welcome to Wonderland");
+}
+
+TEST_F(ParamViewsTest, StringAndViewSpansShareCacheEntries) {
+    const std::vector<std::string> strings = {"Alice"};
+    const std::vector<std::string_view> views = {"Alice"};
+    EXPECT_EQ(i18n.tr("welcome", strings), "Welcome, Alice!");
+    const size_t size = i18n.translationCacheSize();
+    EXPECT_EQ(i18n.tr("welcome", views), "Welcome, Alice!");
+    EXPECT_EQ(i18n.translationCacheSize(), size);
+}
+
+TEST_F(ParamViewsTest, CountIsSlotZero) {
+    // {0} is the count; caller params start at {1}
+    const std::vector<std::string_view> params = {"cart"};
+    EXPECT_EQ(i18n.trPlural("items_in_cart", -2, params), "-2 items in cart");
+    EXPECT_EQ(i18n.trPlural("items_plural", 2147483647), "2147483647 items");
+}
+
+// Converts to std::string but not to std::string_view
+struct Name {
+    std::string value;
+    operator std::string() const { return value; }
+};
+
+TEST_F(ParamViewsTest, StringInitializerListsStillBind) {
+    const std::initializer_list<std::string> params = {"Alice", "Wonderland"};
+    EXPECT_EQ(i18n.tr("welcome_pos", params), "Hello Alice, welcome to Wonderland");
+    EXPECT_EQ(i18n.tr("welcome_pos", {std::string("Alice"), std::string("Wonderland")}),
+              "Hello Alice, welcome to Wonderland");
+    EXPECT_EQ(i18n.tr("welcome_pos", {Name{"Alice"}, Name{"Wonderland"}}), "Hello Alice, welcome to Wonderland");
+    EXPECT_EQ(i18n.trPlural("items_in_cart", 3, {Name{"cart"}}), "3 items in cart");
+}
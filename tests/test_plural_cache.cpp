@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <string>
+
+class PluralCacheTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.load({
+            {"en", {
+                {"comments", {{"one", "{0} comment"}, {"other", "{0} comments"}}},
+                {"seats", {{"one", "{0} seat in {1}"}, {"other", "{0} seats in {1}"}}},
+                {"steps", {"none", "first", "second"}},
+                {"counted", "{0} things"}
+            }},
+            {"ru", {
+                {"comments", {{"one", "{0} комментарий"}, {"few", "{0} комментария"}, {"many", "{0} комментариев"}}}
+            }}
+        });
+        i18n.setLocale("en");
+        i18n.setFallbackLocale("en");
+    }
+};
+
+TEST_F(PluralCacheTest, CacheHoldsOneEntryPerCategory) {
+    for (int n = 0; n < 1000; ++n) {
+        ASSERT_EQ(i18n.trPlural("comments", n), std::to_string(n) + (n == 1 ? " comment" : " comments"));
+    }
+    EXPECT_EQ(i18n.translationCacheSize(), 2u);
+}
+
+TEST_F(PluralCacheTest, CategoriesFollowEveryChainLocale) {
+    i18n.setLocale("ru");
+    for (int n = 0; n < 1000; ++n) {
+        (void)i18n.trPlural("comments", n);
+    }
+    // ru one/few/many crossed with en one/other: ru "one" never meets en "one" past 1
+    EXPECT_LE(i18n.translationCacheSize(), 6u);
+    EXPECT_EQ(i18n.trPlural("comments", 1), "1 комментарий");
+    EXPECT_EQ(i18n.trPlural("comments", 3), "3 комментария");
+    EXPECT_EQ(i18n.trPlural("comments", 11), "11 комментариев");
+    EXPECT_EQ(i18n.trPlural("comments", 21), "21 комментарий");
+}
+
+TEST_F(PluralCacheTest, ParamsAreSubstitutedPerCall) {
+    EXPECT_EQ(i18n.trPlural("seats", 2, {"row A"}), "2 seats in row A");
+    EXPECT_EQ(i18n.trPlural("seats", 3, {"row B"}), "3 seats in row B");
+    EXPECT_EQ(i18n.trPlural("seats", 1, {"row C"}), "1 seat in row C");
+    EXPECT_EQ(i18n.translationCacheSize(), 2u);
+}
+
+TEST_F(PluralCacheTest, ExactCountFormsStillSelectByCount) {
+    EXPECT_EQ(i18n.trPlural("steps", 0), "none");
+    EXPECT_EQ(i18n.trPlural("steps", 1), "first");
+    EXPECT_EQ(i18n.trPlural("steps", 2), "second");
+    EXPECT_EQ(i18n.trPlural("steps", 2), "second");
+    EXPECT_EQ(i18n.trPlural("steps", 7), "steps");
+}
+
+TEST_F(PluralCacheTest, DirectKeyAndMisses) {
+    EXPECT_EQ(i18n.trPlural("counted", 7), "7 things");
+    EXPECT_EQ(i18n.trPlural("counted", 8), "8 things");
+    EXPECT_EQ(i18n.trPlural("missing", 8), "missing");
+    EXPECT_EQ(i18n.trPlural("missing", 9), "missing");
+}
+
+TEST_F(PluralCacheTest, InvalidatedByCatalogChange) {
+    EXPECT_EQ(i18n.trPlural("comments", 5), "5 comments");
+    i18n.load({{"en", {{"comments", {{"one", "{0} reply"}, {"other", "{0} replies"}}}}}});
+    EXPECT_EQ(i18n.trPlural("comments", 5), "5 replies");
+}
+
+TEST_F(PluralCacheTest, RepeatedCallMatchesCountAndParams) {
+    EXPECT_EQ(i18n.trPlural("seats", 2, {"row A"}), "2 seats in row A");
+    EXPECT_EQ(i18n.trPlural("seats", 2, {"row A"}), "2 seats in row A");
+    EXPECT_EQ(i18n.trPlural("seats", 2, {"row B"}), "2 seats in row B");
+    EXPECT_EQ(i18n.trPlural("seats", 3, {"row B"}), "3 seats in row B");
+    // "1\0" + "2" must not match "12" with no params
+    EXPECT_EQ(i18n.trPlural("counted", 12), "12 things");
+    EXPECT_EQ(i18n.trPlural("counted", 1, {"2"}), "1 things");
+}
+
+TEST_F(PluralCacheTest, ReloadWithoutCountFormsReturnsToCategoryCache) {
+    i18n.load({{"en", {{"steps", {{"one", "{0} step"}, {"other", "{0} steps"}}}}}});
+    for (int n = 0; n < 100; ++n) {
+        ASSERT_EQ(i18n.trPlural("steps", n), std::to_string(n) + (n == 1 ? " step" : " steps"));
+    }
+    EXPECT_EQ(i18n.translationCacheSize(), 2u);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+class RelativeTimeTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.load(nlohmann::json::parse(R"json({
+            "en": {"title": "Feed"},
+            "ru": {
+                "_formats": {
+                    "relative": {
+                        "now": "сейчас",
+                        "past": {
+                            "minute": {"one": "{0} минуту назад", "few": "{0} минуты назад", "many": "{0} минут назад"},
+                            "day": {"one": "вчера", "other": "{0} дня назад"}
+                        },
+                        "future": {
+                            "minute": {"one": "через {0} минуту", "few": "через {0} минуты", "many": "через {0} минут"}
+                        }
+                    }
+                }
+            }
+        })json"));
+        i18n.setLocale("en");
+    }
+};
+
+TEST_F(RelativeTimeTest, PicksLargestWholeUnit) {
+    EXPECT_EQ(i18n.formatRelative(0s), "now");
+    EXPECT_EQ(i18n.formatRelative(-1s), "1 second ago");
+    EXPECT_EQ(i18n.formatRelative(-59s), "59 seconds ago");
+    EXPECT_EQ(i18n.formatRelative(-180s), "3 minutes ago");
+    EXPECT_EQ(i18n.formatRelative(-3599s), "59 minutes ago");
+    EXPECT_EQ(i18n.formatRelative(std::chrono::hours(-1)), "1 hour ago");
+    EXPECT_EQ(i18n.formatRelative(std::chrono::hours(48)), "in 2 days");
+    EXPECT_EQ(i18n.formatRelative(std::chrono::hours(-24 * 15)), "2 weeks ago");
+    EXPECT_EQ(i18n.formatRelative(std::chrono::hours(24 * 45)), "in 1 month");
+    EXPECT_EQ(i18n.formatRelative(std::chrono::hours(-24 * 800)), "2 years ago");
+}
+
+TEST_F(RelativeTimeTest, UsesLocalePluralRules) {
+    i18n.setLocale("ru");
+    EXPECT_EQ(i18n.formatRelative(0s), "сейчас");
+    EXPECT_EQ(i18n.formatRelative(-60s), "1 минуту назад");
+    EXPECT_EQ(i18n.formatRelative(-180s), "3 минуты назад");
+    EXPECT_EQ(i18n.formatRelative(-300s), "5 минут назад");
+    EXPECT_EQ(i18n.formatRelative(-21 * 60s), "21 минуту назад");
+    EXPECT_EQ(i18n.formatRelative(120s), "через 2 минуты");
+}
+
+TEST_F(RelativeTimeTest, TemplateWithoutCountAndOtherFallback) {
+    i18n.setLocale("ru");
+    EXPECT_EQ(i18n.formatRelative(std::chrono::hours(-24)), "вчера");
+    EXPECT_EQ(i18n.formatRelative(std::chrono::hours(-72)), "3 дня назад");
+    // Units the locale does not override keep the built-in templates
+    EXPECT_EQ(i18n.formatRelative(std::chrono::hours(-2)), "2 hours ago");
+}
+
+TEST_F(RelativeTimeTest, ExtremeDeltas) {
+    EXPECT_EQ(i18n.formatRelative(std::chrono::seconds(std::numeric_limits<int64_t>::min())),
+              std::to_string(9223372036854775808ull / 31556952) + " years ago");
+    EXPECT_EQ(i18n.formatRelative(std::chrono::seconds(std::numeric_limits<int64_t>::max())),
+              "in " + std::to_string(9223372036854775807ll / 31556952) + " years");
+}
+
+TEST_F(RelativeTimeTest, BatchMatchesSingleCalls) {
+    const std::vector<std::chrono::seconds> deltas = {
+        0s, -5s, -5s, -59s, -60s, -61s, -119s, -120s, -7200s, -7300s, 3600s, 0s,
+        std::chrono::hours(-24 * 400)
+    };
+    i18n::BatchOutput out;
+    i18n.formatRelativeBatch(deltas, out);
+    ASSERT_EQ(out.size(), deltas.size());
+    for (size_t i = 0; i < deltas.size(); ++i) {
+        EXPECT_EQ(out[i], i18n.formatRelative(deltas[i])) << i;
+    }
+}
+
+TEST_F(RelativeTimeTest, BatchSharesRepeatedResults) {
+    const std::vector<std::chrono::seconds> deltas = {-60s, -61s, -119s, -120s};
+    i18n::BatchOutput out;
+    i18n.formatRelativeBatch(deltas, out);
+    EXPECT_EQ(out[0].data(), out[2].data());
+    EXPECT_EQ(out.arena(), "1 minute ago2 minutes ago");
+}
+
+TEST_F(RelativeTimeTest, LocaleSwitchRecompiles) {
+    EXPECT_EQ(i18n.formatRelative(-180s), "3 minutes ago");
+    i18n.setLocale("ru");
+    EXPECT_EQ(i18n.formatRelative(-180s), "3 минуты назад");
+    i18n.setLocale("en");
+    EXPECT_EQ(i18n.formatRelative(-180s), "3 minutes ago");
+}
+
+TEST_F(RelativeTimeTest, ResetDropsCompiledFormatter) {
+    i18n.setLocale("ru");
+    EXPECT_EQ(i18n.formatRelative(0s), "сейчас");
+    i18n.reset();
+    EXPECT_EQ(i18n.formatRelative(0s), i18n::I18N().formatRelative(0s));
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <string>
+#include <vector>
+
+using i18n::Escape;
+
+class SegmentsTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.load({
+            {"en", {
+                {"welcome", "Welcome back, {0}! You have {1} new messages."},
+                {"total", "Total: {0:number}{1:number}"},
+                {"padded", "[{0,6}]"},
+                {"html", "<p>{0}</p>"}
+            }}
+        });
+        i18n.setLocale("en");
+    }
+};
+
+TEST_F(SegmentsTest, MatchesTrf) {
+    i18n::SegmentedOutput out;
+    const std::string name = "Ann";
+    i18n.trfSegments(out, "welcome", std::vector<i18n::FormatArg>{name, 3});
+    EXPECT_EQ(out.str(), i18n.trf("welcome", {name, 3}));
+    EXPECT_EQ(out.byteSize(), out.str().size());
+}
+
+TEST_F(SegmentsTest, ReferencesCatalogAndArgumentsInPlace) {
+    i18n::SegmentedOutput out;
+    const std::string name = "Ann";
+    i18n.trfSegments(out, "welcome", std::vector<i18n::FormatArg>{name, 3});
+    ASSERT_EQ(out.size(), 5u);
+    EXPECT_EQ(out[0], "Welcome back, ");
+    EXPECT_EQ(out[1].data(), name.data());
+    EXPECT_EQ(out[2], "! You have ");
+    EXPECT_EQ(out[3], "3");
+    EXPECT_EQ(out[4], " new messages.");
+
+    // Literal segments point into the same storage on every render
+    const char* literal = out[0].data();
+    i18n.trfSegments(out, "welcome", std::vector<i18n::FormatArg>{name, 4});
+    EXPECT_EQ(out[0].data(), literal);
+}
+
+TEST_F(SegmentsTest, AdjacentFormattedFieldsShareOneSegment) {
+    i18n::SegmentedOutput out;
+    i18n.trfSegments(out, "total", std::vector<i18n::FormatArg>{1, 2});
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out[0], "Total: ");
+    EXPECT_EQ(out[1], i18n.trf("total", {1, 2}).substr(7));
+}
+
+TEST_F(SegmentsTest, PaddedAndEscapedArgsAreBuffered) {
+    i18n::SegmentedOutput out;
+    i18n.trfSegments(out, "padded", std::vector<i18n::FormatArg>{"ab"});
+    EXPECT_EQ(out.str(), "[    ab]");
+
+    i18n.trfSegments(out, "html", std::vector<i18n::FormatArg>{"a<b"}, Escape::Html);
+    EXPECT_EQ(out.str(), i18n.trf("html", {"a<b"}, Escape::Html));
+}
+
+TEST_F(SegmentsTest, MissingKeyIsCopied) {
+    i18n::SegmentedOutput out;
+    std::string key = "missing.key";
+    i18n.trfSegments(out, key, {});
+    key.assign("xxxxxxxxxxx");
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_EQ(out[0], "missing.key");
+}
+
+TEST_F(SegmentsTest, EscapedLiteralsSurviveTemplateCacheGrowth) {
+    i18n::SegmentedOutput out;
+    i18n.trfSegments(out, "html", std::vector<i18n::FormatArg>{"x"}, Escape::Html);
+    const std::string before = out.str();
+    for (int i = 0; i < 64; ++i) {
+        i18n.trf("missing." + std::to_string(i), {}, Escape::Json);
+    }
+    EXPECT_EQ(out.str(), before);
+}
+
+#ifdef I18N_HAS_IOVEC
+TEST_F(SegmentsTest, ConvertsToIovecs) {
+    i18n::SegmentedOutput out;
+    i18n.trfSegments(out, "welcome", std::vector<i18n::FormatArg>{"Bo", 1});
+    std::vector<iovec> iov;
+    out.toIovecs(iov);
+    ASSERT_EQ(iov.size(), out.size());
+    std::string joined;
+    for (const iovec& entry : iov) {
+        joined.append(static_cast<const char*>(entry.iov_base), entry.iov_len);
+    }
+    EXPECT_EQ(joined, out.str());
+}
+#endif
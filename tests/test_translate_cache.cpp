@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <string>
+
+class TranslateCacheTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.load({
+            {"en", {
+                {"welcome", "%{name} has arrived"},
+                {"balance", "%{name} owes %<amount>.d"},
+                {"visits", {{"one", "%{count} visit"}, {"other", "%{count} visits"}}},
+                {"pronoun", {{"male", "he"}, {"female", "she"}, {"other", "they"}}},
+                {"greeting", "Hello"}
+            }},
+            {"de", {{"greeting", "Hallo"}}}
+        });
+        i18n.setLocale("en");
+    }
+};
+
+TEST_F(TranslateCacheTest, RepeatCallsHitTheCache) {
+    EXPECT_EQ(i18n.translate("welcome", {{"name", "Alice"}}), "Alice has arrived");
+    const size_t size = i18n.translationCacheSize();
+    EXPECT_EQ(i18n.translate("welcome", {{"name", "Alice"}}), "Alice has arrived");
+    EXPECT_EQ(i18n.translationCacheSize(), size);
+    EXPECT_EQ(i18n.translate("welcome", {{"name", "Bob"}}), "Bob has arrived");
+}
+
+TEST_F(TranslateCacheTest, UnreferencedParamsDoNotFragmentTheCache) {
+    EXPECT_EQ(i18n.translate("balance", {{"name", "Al"}, {"amount", 3.5}, {"ts", 1}}), "Al owes 3");
+    const size_t size = i18n.translationCacheSize();
+    EXPECT_EQ(i18n.translate("balance", {{"name", "Al"}, {"amount", 3.5}, {"ts", 2}}), "Al owes 3");
+    EXPECT_EQ(i18n.translationCacheSize(), size);
+}
+
+TEST_F(TranslateCacheTest, ReferencedNumericParamsAreKeyed) {
+    EXPECT_EQ(i18n.translate("balance", {{"name", "Al"}, {"amount", 3.5}}), "Al owes 3");
+    EXPECT_EQ(i18n.translate("balance", {{"name", "Al"}, {"amount", 7}}), "Al owes 7");
+    EXPECT_EQ(i18n.translate("balance", {{"name", "Al"}}), "Al owes %<amount>.d");
+}
+
+TEST_F(TranslateCacheTest, NumericTypesAreDistinguished) {
+    // 5 and 5.0 interpolate differently through %{name}
+    EXPECT_EQ(i18n.translate("welcome", {{"name", 5}}), "5 has arrived");
+    EXPECT_EQ(i18n.translate("welcome", {{"name", 5.0}}), "5.0 has arrived");
+    EXPECT_EQ(i18n.translate("welcome", {{"name", true}}), "true has arrived");
+}
+
+TEST_F(TranslateCacheTest, CountSelectsPluralForm) {
+    EXPECT_EQ(i18n.translate("visits", {{"count", 1}}), "1 visit");
+    EXPECT_EQ(i18n.translate("visits", {{"count", 3}}), "3 visits");
+    EXPECT_EQ(i18n.translate("visits", {{"count", 1}}), "1 visit");
+}
+
+TEST_F(TranslateCacheTest, StringParamsSelectVariants) {
+    EXPECT_EQ(i18n.translate("pronoun", {{"gender", "female"}}), "she");
+    EXPECT_EQ(i18n.translate("pronoun", {{"gender", "male"}}), "he");
+    EXPECT_EQ(i18n.translate("pronoun", {{"gender", "unknown"}}), "they");
+    EXPECT_EQ(i18n.translate("pronoun", {{"gender", "female"}}), "she");
+}
+
+TEST_F(TranslateCacheTest, LocaleParamIsPartOfTheKey) {
+    EXPECT_EQ(i18n.translate("greeting"), "Hello");
+    EXPECT_EQ(i18n.translate("greeting", {{"locale", "de"}}), "Hallo");
+    EXPECT_EQ(i18n.translate("greeting"), "Hello");
+}
+
+TEST_F(TranslateCacheTest, DefaultAndMissAreCached) {
+    EXPECT_EQ(i18n.translate("missing", {{"default", "Hi %{name}"}, {"name", "Al"}}), "Hi Al");
+    EXPECT_EQ(i18n.translate("missing", {{"default", "Hi %{name}"}, {"name", "Bo"}}), "Hi Bo");
+    EXPECT_EQ(i18n.translate("missing"), "missing");
+    EXPECT_EQ(i18n.translate("missing"), "missing");
+}
+
+TEST_F(TranslateCacheTest, ValuesThatSpliceReferencesBypassTheCache) {
+    // The first pass substitutes "%<amount>.d", which the second pass expands
+    const size_t size = i18n.translationCacheSize();
+    EXPECT_EQ(i18n.translate("welcome", {{"name", "%<amount>.d"}, {"amount", 1}}), "1 has arrived");
+    EXPECT_EQ(i18n.translate("welcome", {{"name", "%<amount>.d"}, {"amount", 2}}), "2 has arrived");
+    EXPECT_EQ(i18n.translationCacheSize(), size);
+}
+
+TEST_F(TranslateCacheTest, LoadInvalidatesCache) {
+    EXPECT_EQ(i18n.translate("welcome", {{"name", "Al"}}), "Al has arrived");
+    i18n.load({{"en", {{"welcome", "Welcome, %{name}"}}}});
+    EXPECT_EQ(i18n.translate("welcome", {{"name", "Al"}}), "Welcome, Al");
+}
+
+TEST_F(TranslateCacheTest, CacheIsBounded) {
+    for (int i = 0; i < 10000; ++i) {
+        (void)i18n.translate("welcome", {{"name", std::to_string(i)}});
+    }
+    EXPECT_LE(i18n.translationCacheSize(), 4096u);
+    EXPECT_EQ(i18n.translate("welcome", {{"name", "9999"}}), "9999 has arrived");
+
+    // Numeric values reuse one template but each gets its own rendered entry
+    for (int i = 0; i < 10000; ++i) {
+        (void)i18n.translate("balance", {{"name", "Al"}, {"amount", i}});
+    }
+    EXPECT_LE(i18n.translationCacheSize(), 4096u);
+    EXPECT_EQ(i18n.translate("balance", {{"name", "Al"}, {"amount", 9999}}), "Al owes 9999");
+}
+
+TEST_F(TranslateCacheTest, ResetClearsCache) {
+    EXPECT_EQ(i18n.translate("welcome", {{"name", "Al"}}), "Al has arrived");
+    i18n.reset();
+    EXPECT_EQ(i18n.translationCacheSize(), 0u);
+    EXPECT_EQ(i18n.translate("welcome", {{"name", "Al"}}), "welcome");
+}
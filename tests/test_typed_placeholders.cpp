@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <chrono>
+#include <ctime>
+#include <string>
+
+class TypedPlaceholdersTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.load({
+            {"en", {
+                {"plain", "{0} bought {1} items for {2}"},
+                {"unnumbered", "{} and {}"},
+                {"total", "Total: {0:number}"},
+                {"price", "Due: {0:price}"},
+                {"shipped", "Shipped {0:date:short_date} at {0:date:%H:%M}"},
+                {"iso", "At {0}"},
+                {"table", "[{0,6}|{1,-6}|{2,8:number}]"},
+                {"literal_braces", "{name} {0:unknown} {x} {0,} {0}"},
+                {"missing_arg", "{0} {3:number}"}
+            }}
+        });
+        i18n.setLocale("en");
+        i18n.configure(nlohmann::json::parse(R"({
+            "number": {"thousand_separator": ",", "fract_digits": 2},
+            "currency": {"symbol": "$", "positive_format": "%c%p%q", "negative_format": "%c%p%q",
+                         "thousand_separator": ",", "negative_symbol": "-"},
+            "date_time": {"short_date": "%d/%m/%Y"}
+        })"));
+    }
+
+    static std::tm fixedTm() {
+        std::tm tm = {};
+        tm.tm_year = 126;
+        tm.tm_mon = 2;
+        tm.tm_mday = 15;
+        tm.tm_hour = 14;
+        tm.tm_min = 30;
+        tm.tm_sec = 45;
+        return tm;
+    }
+};
+
+TEST_F(TypedPlaceholdersTest, PlainArgsOfEveryKind) {
+    EXPECT_EQ(i18n.trf("plain", {"Ann", 3, 4.25}), "Ann bought 3 items for 4.25");
+    EXPECT_EQ(i18n.trf("unnumbered", {true, "x"}), "true and x");
+}
+
+TEST_F(TypedPlaceholdersTest, NumberUsesActiveConfig) {
+    EXPECT_EQ(i18n.trf("total", {1234567.891}), "Total: 1,234,567.89");
+    EXPECT_EQ(i18n.trf("total", {-42}), "Total: -42.00");
+    EXPECT_EQ(i18n.trf("total", {1234567.891}), "Total: " + i18n.formatNumber(1234567.891));
+}
+
+TEST_F(TypedPlaceholdersTest, PriceMatchesFormatPrice) {
+    EXPECT_EQ(i18n.trf("price", {1234.5}), "Due: " + i18n.formatPrice(1234.5));
+    EXPECT_EQ(i18n.trf("price", {-3}), "Due: $-3.00");
+}
+
+TEST_F(TypedPlaceholdersTest, DateWithNamedAndLiteralPatterns) {
+    const std::tm tm = fixedTm();
+    EXPECT_EQ(i18n.trf("shipped", {tm}), "Shipped 15/03/2026 at 14:30");
+    EXPECT_EQ(i18n.trf("iso", {tm}), "At 2026-03-15T14:30:45");
+}
+
+TEST_F(TypedPlaceholdersTest, TimePointArgs) {
+    std::tm tm = fixedTm();
+    tm.tm_isdst = -1;
+    const auto when = std::chrono::system_clock::from_time_t(std::mktime(&tm));
+    EXPECT_EQ(i18n.trf("shipped", {when}), "Shipped 15/03/2026 at 14:30");
+}
+
+TEST_F(TypedPlaceholdersTest, WidthAndAlignment) {
+    EXPECT_EQ(i18n.trf("table", {"ab", "cd", 5}), "[    ab|cd    |    5.00]");
+    // Values wider than the field are not truncated
+    EXPECT_EQ(i18n.trf("table", {"abcdefgh", "x", 1234567}), "[abcdefgh|x     |1,234,567.00]");
+}
+
+TEST_F(TypedPlaceholdersTest, InvalidSpecsStayLiteral) {
+    EXPECT_EQ(i18n.trf("literal_braces", {7}), "{name} {0:unknown} {x} {0,} 7");
+}
+
+TEST_F(TypedPlaceholdersTest, MissingArgKeepsPlaceholder) {
+    EXPECT_EQ(i18n.trf("missing_arg", {1}), "1 {3:number}");
+}
+
+TEST_F(TypedPlaceholdersTest, WrongKindFallsBackToPlain) {
+    EXPECT_EQ(i18n.trf("total", {"n/a"}), "Total: n/a");
+}
+
+TEST_F(TypedPlaceholdersTest, MissingKeyReturnsKey) {
+    EXPECT_EQ(i18n.trf("nope", {1}), "nope");
+    EXPECT_EQ(i18n.trf("", {1}), "");
+}
+
+TEST_F(TypedPlaceholdersTest, TrfIntoAppends) {
+    std::string out = "> ";
+    const i18n::FormatArg args[] = {12.5};
+    i18n.trfInto(out, "total", args);
+    EXPECT_EQ(out, "> Total: 12.50");
+}
+
+TEST_F(TypedPlaceholdersTest, ConfigureAndReloadRecompile) {
+    EXPECT_EQ(i18n.trf("total", {1000}), "Total: 1,000.00");
+    i18n.configure(nlohmann::json::parse(R"({"number": {"thousand_separator": "."}})"));
+    EXPECT_EQ(i18n.trf("total", {1000}), "Total: 1.000.00");
+    i18n.load({{"en", {{"total", "Sum {0:number}"}}}});
+    EXPECT_EQ(i18n.trf("total", {1000}), "Sum 1.000.00");
+}
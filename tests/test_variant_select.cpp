@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "i18ncpp.h"
+#include <string>
+
+class VariantSelectTest : public ::testing::Test {
+protected:
+    i18n::I18N i18n;
+
+    void SetUp() override {
+        i18n.load({
+            {"en", {
+                {"pronoun", {{"male", "he"}, {"female", "she"}, {"other", "they"}}},
+                {"invite", {{"male", "%{host} invites him"}, {"female", "%{host} invites her"}}},
+                {"settings", {{"title", "Settings"}, {"privacy", {{"title", "Privacy"}}}}}
+            }},
+            {"de", {
+                {"pronoun", {{"female", "sie"}, {"other", "they (de)"}}}
+            }}
+        });
+        i18n.setLocale("de");
+        i18n.setFallbackLocale("en");
+    }
+};
+
+TEST_F(VariantSelectTest, ParamValueSelectsForm) {
+    EXPECT_EQ(i18n.translate("pronoun", {{"gender", "female"}}), "sie");
+    EXPECT_EQ(i18n.translate("pronoun", {{"gender", "unknown"}}), "they (de)");
+}
+
+TEST_F(VariantSelectTest, FormMissingInLocaleFallsBackToOther) {
+    // "de" has no pronoun.male, so its own "other" wins over en's "male"
+    EXPECT_EQ(i18n.translate("pronoun", {{"gender", "male"}}), "they (de)");
+}
+
+TEST_F(VariantSelectTest, FormOnlyInFallbackLocale) {
+    EXPECT_EQ(i18n.translate("invite", {{"gender", "female"}, {"host", "Al"}}), "Al invites her");
+}
+
+TEST_F(VariantSelectTest, SelectNamesTheDiscriminator) {
+    // Without "select" the first matching string param in key order wins
+    const i18n::json params = {{"a_speaker", "male"}, {"listener", "female"}};
+    EXPECT_EQ(i18n.translate("pronoun", params), "they (de)");
+
+    i18n::json selected = params;
+    selected["select"] = "listener";
+    EXPECT_EQ(i18n.translate("pronoun", selected), "sie");
+}
+
+TEST_F(VariantSelectTest, SelectOfMissingParamUsesOther) {
+    EXPECT_EQ(i18n.translate("pronoun", {{"select", "gender"}, {"speaker", "female"}}), "they (de)");
+}
+
+TEST_F(VariantSelectTest, NestedSectionsAreNotVariants) {
+    i18n.setLocale("en");
+    // "settings" holds a nested object, so "title" is a child key, not a form
+    EXPECT_EQ(i18n.translate("settings", {{"section", "title"}}), "settings");
+    EXPECT_EQ(i18n.translate("settings.privacy", {{"section", "title"}}), "Privacy");
+}
+
+TEST_F(VariantSelectTest, MergedFormsAreSelectable) {
+    i18n.load({{"de", {{"pronoun", {{"male", "er"}, {"female", "sie"}, {"other", "they (de)"}}}}}});
+    EXPECT_EQ(i18n.translate("pronoun", {{"gender", "male"}}), "er");
+}
+
+TEST_F(VariantSelectTest, VariantShapeIsDecidedPerLocale) {
+    // "greeting" is a leaf object in en but nested in fr
+    i18n.load({
+        {"en", {{"greeting", {{"formal", "Good day"}, {"casual", "Hi"}}}}},
+        {"fr", {{"greeting", {{"formal", {{"morning", "Bonjour"}}}, {"casual", {{"morning", "Salut"}}}}}}}
+    });
+    i18n.setLocale("en");
+    EXPECT_EQ(i18n.translate("greeting", {{"tone", "casual"}}), "Hi");
+
+    // fr has no leaf forms, so the selection comes from the en fallback
+    i18n.setLocale("fr");
+    EXPECT_EQ(i18n.translate("greeting", {{"tone", "casual"}}), "Hi");
+    EXPECT_EQ(i18n.translate("greeting.casual", {{"tone", "morning"}}), "Salut");
+}